@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_CONFIG_PSI_CONFIG_H
+#define OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_CONFIG_PSI_CONFIG_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "libxml/parser.h"
+
+namespace OHOS {
+namespace Memory {
+enum StallType {
+    SOME,
+    FULL,
+    STALL_TYPE_COUNT
+};
+
+// default trigger: 10ms out of 1sec for partial stall
+constexpr unsigned int PSI_DEFAULT_THRESHOLD_MS = 10;
+constexpr unsigned int PSI_DEFAULT_WINDOW_MS = 1000;
+// window of psi trigger is limited by kernel
+constexpr unsigned int PSI_MIN_WINDOW_MS = 500;
+constexpr unsigned int PSI_MAX_WINDOW_MS = 10000;
+constexpr unsigned int PSI_MAX_LEVEL_COUNT = 8;
+
+struct PsiTriggerConfig {
+    StallType stallType;
+    unsigned int thresholdMs;
+    unsigned int windowMs;
+};
+
+/*
+ * Psi triggers to monitor, the index of a trigger is its level.
+ * Levels are listed from the mildest stall to the most urgent one.
+ */
+class PsiConfig {
+public:
+    using PsiTriggerList = std::vector<PsiTriggerConfig>;
+    PsiConfig();
+    void SetDefaultConfig();
+    void ParseConfig(const xmlNodePtr &rootNodePtr);
+    bool ParsePsiLevelNode(const xmlNodePtr &currNodePtr, std::map<std::string, std::string> &param);
+    const PsiTriggerList& GetPsiTriggers() const;
+    void Dump(int fd);
+
+private:
+    PsiTriggerList psiTriggers_;
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_CONFIG_PSI_CONFIG_H
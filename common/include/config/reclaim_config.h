@@ -65,6 +65,13 @@ struct ZswapdParamPtrCmp {
     };
 };
 
+struct RatioControllerConfig {
+    unsigned int maxOffset = RATIO_CONTROLLER_MAX_OFFSET;
+    unsigned int step = RATIO_CONTROLLER_STEP;
+    unsigned int refaultHigh = RATIO_CONTROLLER_REFAULT_HIGH;
+    unsigned int refaultLow = RATIO_CONTROLLER_REFAULT_LOW;
+};
+
 class ReclaimConfig {
 public:
     void ParseConfig(const xmlNodePtr &rootNodePtr);
@@ -77,9 +84,17 @@ public:
     void CheckZswapdParam(std::shared_ptr<ZswapdParam> zswapdParam);
     void SetDefaultConfig(int minScore, int maxScore, unsigned int mem2zramRatio,
                           unsigned int zram2ufsRatio, unsigned int refaultThreshold);
+    void ParseMemcgStatsSamplerConfig(const xmlNodePtr &rootNodePtr);
+    unsigned int GetStatsSamplePeriodMs() const;
+    unsigned int GetStatsSampleCount() const;
+    void ParseRatioControllerConfig(const xmlNodePtr &rootNodePtr);
+    const RatioControllerConfig& GetRatioControllerConfig() const;
     void Dump(int fd);
 private:
     ReclaimConfigSet reclaimConfigSet_;
+    unsigned int statsSamplePeriodMs_ = MEMCG_STATS_SAMPLE_PERIOD_MS;
+    unsigned int statsSampleCount_ = MEMCG_STATS_SAMPLE_COUNT;
+    RatioControllerConfig ratioControllerConfig_;
 };
 } // namespace Memory
 } // namespace OHOS
@@ -31,11 +31,14 @@ public:
     void ParseReclaimPriorityImportantBgAppsConfig(const xmlNodePtr &rootNodePtr);
     std::set<std::string> GetkillalbeSystemApps();
     std::map<std::string, int> GetImportantBgApps();
+    unsigned int GetUpdateCoalesceWindowMs();
     void Dump(int fd);
 
 private:
     std::set<std::string> killalbeSystemApps_;
     std::map<std::string, int> importantBgApps_;
+    // 0: every update is applied at once, or updates in the window are applied together
+    unsigned int updateCoalesceWindowMs_ = 0;
 };
 } // namespace Memory
 } // namespace OHOS
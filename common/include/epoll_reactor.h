@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_EPOLL_REACTOR_H
+#define OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_EPOLL_REACTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "event_handler.h"
+#include "single_instance.h"
+
+struct epoll_event;
+
+namespace OHOS {
+namespace Memory {
+// events of one epoll_wait are dispatched in this order
+enum class ReactorPriority {
+    URGENT = 0, // memory pressure, e.g. psi triggers
+    HIGH, // process death, e.g. pidfds
+    NORMAL, // others, e.g. kswapd and timerfds
+    COUNT
+};
+
+/*
+ * Single epoll set for all kernel fds watched by memmgr, e.g. psi triggers, kswapd monitor,
+ * pidfds and timerfds, so that only one thread is blocked in epoll_wait.
+ * Handlers are called on the reactor thread. They must be short, heavy work should be posted
+ * to the handler thread of its owner.
+ */
+class EpollReactor {
+    DECLARE_SINGLE_INSTANCE_BASE(EpollReactor);
+
+public:
+    using FdHandler = std::function<void(int fd, uint32_t events)>;
+
+    // watch the fd, the reactor thread is started at the first call. The fd is still owned by caller.
+    bool AddFd(int fd, uint32_t events, ReactorPriority priority, const std::string &name, FdHandler handler);
+    // stop watching the fd, it should be called before the fd is closed.
+    // it may be called in the handler, but a handler running on the reactor thread is not waited.
+    bool RemoveFd(int fd);
+    bool IsWatching(int fd);
+    size_t Size();
+    void Dump(int fd);
+
+private:
+    struct Watcher {
+        uint64_t id = 0;
+        int fd = -1;
+        uint32_t events = 0;
+        ReactorPriority priority = ReactorPriority::NORMAL;
+        std::string name;
+        FdHandler handler;
+        std::atomic<uint64_t> dispatched {0};
+    };
+
+    EpollReactor();
+    ~EpollReactor();
+    bool StartLocked();
+    void MainLoop();
+    void DispatchEvents(struct epoll_event *events, int count);
+    bool IsRegistered(const std::shared_ptr<Watcher> &watcher);
+
+    std::mutex watchersLock_;
+    // keyed by watcher id, the id is carried by epoll events instead of fd, so events of
+    // a removed fd are never dispatched to a new watcher of the same fd number
+    std::unordered_map<uint64_t, std::shared_ptr<Watcher>> watchers_;
+    std::unordered_map<int, uint64_t> fdToId_;
+    uint64_t nextId_ = 1;
+    int epollfd_ = -1;
+    bool started_ = false;
+    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::atomic<uint64_t> loops_ {0};
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_EPOLL_REACTOR_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_IO_URING_WRITER_H
+#define OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_IO_URING_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace Memory {
+struct WriteRequest {
+    int fd = -1;
+    const char *buf = nullptr;
+    size_t len = 0;
+    bool done = false; // set when the result is reaped
+    int res = 0; // bytes written or -errno, valid if done
+};
+
+/*
+ * Writes many small buffers to kernel control files with one io_uring submission per ring.
+ * It is only built with USE_IO_URING, otherwise and on kernels without io_uring it is never
+ * available and callers should write by themselves. Not thread safe, callers serialize it.
+ */
+class IoUringWriter {
+public:
+    IoUringWriter() = default;
+    ~IoUringWriter();
+    IoUringWriter(const IoUringWriter &) = delete;
+    IoUringWriter &operator=(const IoUringWriter &) = delete;
+
+    // the ring is set up at the first call, and is never retried once failed
+    bool IsAvailable();
+    // return false if the ring is not available or broken, requests not done should be written again
+    bool Write(std::vector<WriteRequest> &requests);
+
+private:
+    bool Setup();
+    void Teardown();
+    bool SubmitAndWait(std::vector<WriteRequest> &requests, size_t begin, size_t count);
+    size_t ReapCompletions(std::vector<WriteRequest> &requests, size_t begin);
+    // reap until every sqe consumed by the kernel is completed, so no buffer is written after return
+    void WaitSubmitted(std::vector<WriteRequest> &requests, size_t begin, size_t submitted, size_t completed);
+
+    bool setupTried_ = false;
+    int ringFd_ = -1;
+    unsigned int sqEntries_ = 0;
+    void *sqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    void *cqRing_ = nullptr;
+    size_t cqRingSize_ = 0;
+    void *sqes_ = nullptr;
+    size_t sqesSize_ = 0;
+    unsigned int *sqHead_ = nullptr;
+    unsigned int *sqTail_ = nullptr;
+    unsigned int *sqMask_ = nullptr;
+    unsigned int *sqArray_ = nullptr;
+    unsigned int *cqHead_ = nullptr;
+    unsigned int *cqTail_ = nullptr;
+    unsigned int *cqMask_ = nullptr;
+    void *cqes_ = nullptr;
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_IO_URING_WRITER_H
@@ -18,10 +18,13 @@
 
 #include <fcntl.h>
 #include <map>
+#include <mutex>
 #include <string>
 #include <sys/types.h>
 #include <vector>
 
+#include "io_uring_writer.h"
+#include "kv_file_reader.h"
 #include "single_instance.h"
 
 namespace OHOS {
@@ -29,6 +32,7 @@ namespace Memory {
 #define PAGE_TO_KB 4
 #define KB_PER_MB 1024
 #define MAX_BUFFER_KB 0x7fffffff
+#define PROC_STATUS_READ_SIZE 1024
 
 struct ProcInfo {
     int tgid;
@@ -39,6 +43,20 @@ struct ProcInfo {
     std::string status;
 };
 
+struct ProcStatus {
+    unsigned int pid = 0;
+    unsigned int tgid = 0;
+    unsigned int uid = 0;
+    std::string name;
+};
+
+struct BatchWriteEntry {
+    int fd = -1; // written if valid, it is still owned by caller
+    std::string path; // opened if fd is invalid, and closed after written
+    std::string content;
+    int error = 0; // 0 if the content is written, or errno
+};
+
 class KernelInterface {
     DECLARE_SINGLE_INSTANCE(KernelInterface);
 
@@ -53,6 +71,11 @@ public:
     bool WriteToFile(const std::string& path, const std::string& content, bool truncated = true);
     bool ReadFromFile(const std::string& path, std::string& content);
     bool ReadLinesFromFile(const std::string& path, std::vector<std::string>& lines);
+    // write contents of all entries with one io_uring submission if available, or one by one.
+    // return the count of entries written, errors are reported by each entry.
+    // entries of one batch may be written in any order, so they should not share a file.
+    int BatchWrite(std::vector<BatchWriteEntry>& entries);
+    bool IsBatchWriteAccelerated();
     // dir operations
     bool IsDirExists(const std::string& path);
     bool IsExists(const std::string& path); // file or dir
@@ -72,8 +95,14 @@ public:
     void ReadZswapdPressureShow(std::map<std::string, std::string>& result);
     int GetCurrentBuffer();
     int KillOneProcessByPid(int pid);
+    int PidfdOpen(pid_t pid);
+    bool PidfdSendSignal(int pidfd, int sig);
+    bool ProcessMrelease(int pidfd);
     bool GetAllProcPids(std::vector<unsigned int>& pids);
     bool GetUidByPid(unsigned int pid, unsigned int& uid);
+    bool GetProcStatusByPid(unsigned int pid, ProcStatus &status);
+    // get pid, tgid, uid and name of all processes by walking /proc once
+    bool GetAllProcStatus(std::vector<ProcStatus> &statusList);
     bool ReadSwapOutKBSinceKernelBoot(const std::string &path, const std::string &tagStr, unsigned long long &ret);
     int64_t GetSystemCurTime();
     int64_t GetSystemTimeMs();
@@ -100,9 +129,12 @@ public:
     static constexpr mode_t FILE_MODE_770 = S_IRWXU | S_IRWXG;
     static constexpr mode_t FILE_MODE_700 = S_IRWXU;
 private:
-    int ParseMeminfo(const std::string &contentStr, const std::string &itemName);
-
     int totalBuffer_ = -1;
+    // persistent readers, avoid open and heap allocation on memory pressure path
+    KvFileReader bufferReader_ {ZWAPD_PRESSURE_SHOW_PATH};
+    KvFileReader meminfoReader_ {MEMINFO_PATH};
+    std::mutex batchWriteLock_;
+    IoUringWriter ioUringWriter_;
 };
 } // namespace Memory
 } // namespace OHOS
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_KV_FILE_READER_H
+#define OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_KV_FILE_READER_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace Memory {
+// max size of content read at one time, enough for /proc/meminfo and memcg stat files
+constexpr size_t KV_FILE_READ_BUF_SIZE = 8192;
+// max count of keys can be queried by one ReadValues/ParseValues call
+constexpr int KV_FILE_MAX_KEYS = 64;
+
+/*
+ * Reader of kernel files in "name: value [unit]" or "name value" format, such as /proc/meminfo,
+ * memory.zswapd_pressure_show and memory.stat.
+ * The file is opened once and re-read by pread into a stack buffer, so reading on the
+ * memory pressure path does not allocate from heap.
+ */
+class KvFileReader {
+public:
+    explicit KvFileReader(const std::string &path);
+    ~KvFileReader();
+    KvFileReader(const KvFileReader&) = delete;
+    KvFileReader& operator=(const KvFileReader&) = delete;
+    KvFileReader(KvFileReader&&) = delete;
+    KvFileReader& operator=(KvFileReader&&) = delete;
+
+    // read the file and set values[i] to the value of keys[i], return the count of keys found, -1 if read failed
+    int ReadValues(const char * const keys[], long long values[], int count);
+    // same as ReadValues, but parse from the given buffer
+    static int ParseValues(const char *buf, size_t len, const char * const keys[], long long values[], int count);
+    const std::string& GetPath() const;
+
+private:
+    int GetFd();
+    void CloseFd();
+
+    std::string path_;
+    std::atomic<int> fd_;
+    std::mutex fdLock_;
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_KV_FILE_READER_H
@@ -31,6 +31,7 @@
 #include "avail_buffer_config.h"
 #include "kill_config.h"
 #include "nand_life_config.h"
+#include "psi_config.h"
 #include "reclaim_config.h"
 #include "reclaim_priority_config.h"
 #include "system_memory_level_config.h"
@@ -50,12 +51,14 @@ public:
     AvailBufferConfig GetAvailBufferConfig();
     SystemMemoryLevelConfig GetSystemMemoryLevelConfig();
     const ReclaimConfig::ReclaimConfigSet& GetReclaimConfigSet();
+    const ReclaimConfig& GetReclaimConfig();
     const ReclaimPriorityConfig& GetReclaimPriorityConfig();
     const KillConfig::KillLevelsMap& GetKillLevelsMap();
     const KillConfig& GetKillConfig();
     const NandLifeConfig& GetNandLifeConfig();
     const SwitchConfig& GetSwitchConfig();
     const PurgeablememConfig &GetPurgeablememConfig();
+    const PsiConfig& GetPsiConfig();
 
 private:
     void InitDefaultConfig();
@@ -71,6 +74,7 @@ private:
     ReclaimPriorityConfig reclaimPriorityConfig_;
     ReclaimConfig reclaimConfig_;
     PurgeablememConfig purgeablememConfig_;
+    PsiConfig psiConfig_;
     void ClearReclaimConfigSet();
     MemmgrConfigManager();
     ~MemmgrConfigManager();
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_MEMMGR_EXECUTOR_H
+#define OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_MEMMGR_EXECUTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "event_handler.h"
+#include "single_instance.h"
+
+namespace OHOS {
+namespace Memory {
+/*
+ * Lanes of the executor, each lane is served by its own thread, so work of one lane never
+ * waits for work of another lane.
+ */
+enum class ExecutorLane {
+    KILL = 0, // low memory killing
+    RECLAIM, // memory level, reclaim and purgeable memory
+    BOOKKEEPING, // priority, account and window state
+    TIMER, // low priority periodic work
+    COUNT
+};
+
+struct LaneStats {
+    uint64_t posted = 0;
+    uint64_t executed = 0;
+    uint64_t cancelled = 0; // removed before running or failed to post
+    int64_t depth = 0; // tasks posted but not started yet, delayed ones included
+    int64_t maxDepth = 0;
+    int64_t maxLatencyMs = 0; // max time a task waits for the lane after it is due
+};
+
+struct LaneCounters {
+    std::atomic<uint64_t> posted {0};
+    std::atomic<uint64_t> executed {0};
+    std::atomic<uint64_t> cancelled {0};
+    std::atomic<int64_t> depth {0};
+    std::atomic<int64_t> maxDepth {0};
+    std::atomic<int64_t> maxLatencyMs {0};
+};
+
+/*
+ * Handler of one lane. It has the posting interface of AppExecFwk::EventHandler used by memmgr,
+ * and counts tasks posted to the lane. Handlers of the same lane share the thread of the lane.
+ */
+class LaneHandler {
+public:
+    using Callback = std::function<void()>;
+    using Priority = AppExecFwk::EventQueue::Priority;
+
+    explicit LaneHandler(ExecutorLane lane);
+    bool PostTask(const Callback &callback, int64_t delayTime = 0, Priority priority = Priority::LOW);
+    bool PostTask(const Callback &callback, const std::string &name, int64_t delayTime = 0,
+        Priority priority = Priority::LOW);
+    bool PostImmediateTask(const Callback &callback, const std::string &name = "");
+    bool PostSyncTask(const Callback &callback, Priority priority = Priority::IMMEDIATE);
+    void RemoveTask(const std::string &name);
+    ExecutorLane GetLane() const;
+
+private:
+    Callback Wrap(const Callback &callback, int64_t delayTime);
+
+    ExecutorLane lane_;
+    LaneCounters *counters_ = nullptr;
+    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+};
+
+/*
+ * Shared executor of memmgr, it owns one event runner for each lane instead of one for
+ * each module, so the count of threads is bounded by the count of lanes.
+ */
+class MemMgrExecutor {
+    DECLARE_SINGLE_INSTANCE_BASE(MemMgrExecutor);
+
+public:
+    // runner of the lane, created at the first call
+    std::shared_ptr<AppExecFwk::EventRunner> GetRunner(ExecutorLane lane);
+    LaneCounters* GetCounters(ExecutorLane lane);
+    bool GetLaneStats(ExecutorLane lane, LaneStats &stats);
+    static const char* GetLaneName(ExecutorLane lane);
+    void Dump(int fd);
+
+private:
+    MemMgrExecutor() = default;
+    ~MemMgrExecutor() = default;
+
+    static constexpr int LANE_COUNT = static_cast<int>(ExecutorLane::COUNT);
+    std::mutex runnersLock_;
+    std::shared_ptr<AppExecFwk::EventRunner> runners_[LANE_COUNT];
+    LaneCounters counters_[LANE_COUNT];
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_MEMMGR_EXECUTOR_H
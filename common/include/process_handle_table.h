@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_PROCESS_HANDLE_TABLE_H
+#define OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_PROCESS_HANDLE_TABLE_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <sys/types.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace Memory {
+struct ProcessHandle {
+    int pidfd = -1;
+    char state = '\0'; // state in /proc/<pid>/stat when sampled
+    int rssKB = 0; // rss when sampled
+    int uid = -1; // uid given when registered
+    bool watched = false; // exit of the process is watched by the epoll reactor
+};
+
+/*
+ * Table of pidfds of managed processes.
+ * A pidfd always refers to the process it is opened for, so signals sent through it
+ * never hit another process which reuses the pid. State and rss are sampled on refresh
+ * and cached here, so that the kill path decides without reading procfs.
+ * Once an exit callback is set, pidfds registered are also watched by the epoll reactor, the
+ * handle of an exited process is dropped and the callback is called on the reactor thread.
+ */
+class ProcessHandleTable {
+    DECLARE_SINGLE_INSTANCE(ProcessHandleTable);
+
+public:
+    using ExitCallback = std::function<void(pid_t pid, int uid)>;
+
+    bool Register(pid_t pid, int uid = -1);
+    // the callback should be short, it is called on the reactor thread
+    void SetExitCallback(ExitCallback callback);
+    // true if exit of every process registered is watched, and no scan is needed to find died ones
+    bool IsExitWatchComplete();
+    void Unregister(pid_t pid);
+    void Clear();
+    bool IsRegistered(pid_t pid);
+    bool GetHandle(pid_t pid, ProcessHandle &handle);
+    // sample state and rss of one process again
+    bool Refresh(pid_t pid);
+    // sample state and rss of all processes, and drop handles of died processes
+    void RefreshAll();
+    // kill the process through pidfd and reap its memory, return false if pid is not registered.
+    // a process at D state by the last refresh is skipped, freedKB is the rss cached
+    bool KillProcess(pid_t pid, int &freedKB);
+    // wait until the processes exit or timeout, return the count of exited processes
+    int WaitForExit(const std::vector<pid_t> &pids, int timeoutMs);
+    size_t Size();
+    void Dump(int fd);
+
+private:
+    bool SampleProcInfo(pid_t pid, ProcessHandle &handle);
+    void CloseHandleLocked(std::unordered_map<pid_t, ProcessHandle>::iterator it);
+    void WatchExitLocked(pid_t pid, ProcessHandle &handle);
+    void HandleExit(pid_t pid, int pidfd);
+
+    std::unordered_map<pid_t, ProcessHandle> handles_;
+    std::mutex handlesLock_;
+    ExitCallback exitCallback_;
+    // processes registered without their exit watched, dropped when unregistered or found died
+    std::unordered_set<pid_t> unwatchedPids_;
+    std::atomic<uint64_t> exitedCount_ {0};
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_PROCESS_HANDLE_TABLE_H
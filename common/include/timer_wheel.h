@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_TIMER_WHEEL_H
+#define OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_TIMER_WHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace Memory {
+/*
+ * Hierarchical timer wheel for many coarse timers, e.g. delayed checks of each process.
+ * Insert and cancel are O(1). The wheel does not own a thread, its owner advances it to
+ * the current time and runs the expired callbacks in one batch, then arms a single task
+ * at NextWakeupMs(). Times are in ms of a monotonic clock given by the owner.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint64_t;
+    using Callback = std::function<void()>;
+    static constexpr TimerId INVALID_TIMER_ID = 0;
+
+    TimerWheel(int64_t tickMs, int64_t nowMs);
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    // the timer expires at the first tick not earlier than nowMs + delayMs
+    TimerId Schedule(int64_t nowMs, int64_t delayMs, Callback callback);
+    // return false if the timer has expired or been cancelled
+    bool Cancel(TimerId id);
+    // move the wheel to nowMs, callbacks expired are appended to expired in order of expiry
+    size_t Advance(int64_t nowMs, std::vector<Callback> &expired);
+    // time the wheel should be advanced next, -1 if there is no timer
+    int64_t NextWakeupMs();
+    size_t Size();
+    void Clear();
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+    struct Timer {
+        TimerId id = INVALID_TIMER_ID;
+        uint64_t expireTick = 0;
+        Callback callback;
+    };
+    using Slot = std::list<Timer>;
+    struct Location {
+        int level = 0;
+        uint64_t slot = 0;
+        Slot::iterator it;
+    };
+
+    void PlaceLocked(Timer &&timer);
+    void CascadeLocked(int level, uint64_t slot);
+    void ExpireLocked(uint64_t tick, std::vector<Callback> &expired);
+    // the first tick to expire or cascade a slot, UINT64_MAX if there is no timer
+    uint64_t NextTickLocked();
+
+    std::mutex lock_;
+    int64_t tickMs_;
+    int64_t baseMs_; // time of tick 0
+    uint64_t currentTick_ = 0; // the last tick processed
+    TimerId nextId_ = 1;
+    Slot wheels_[LEVELS][SLOTS];
+    std::unordered_map<TimerId, Location> index_;
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_COMMON_INCLUDE_TIMER_WHEEL_H
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "memmgr_log.h"
+#include "xml_helper.h"
+#include "psi_config.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+    const std::string TAG = "PsiConfig";
+}
+
+PsiConfig::PsiConfig()
+{
+    SetDefaultConfig();
+}
+
+void PsiConfig::SetDefaultConfig()
+{
+    psiTriggers_.clear();
+    psiTriggers_.push_back({SOME, PSI_DEFAULT_THRESHOLD_MS, PSI_DEFAULT_WINDOW_MS});
+}
+
+void PsiConfig::ParseConfig(const xmlNodePtr &rootNodePtr)
+{
+    if (!XmlHelper::CheckNode(rootNodePtr) || !XmlHelper::HasChild(rootNodePtr)) {
+        HILOGD("Node exsist:%{public}d,has child node:%{public}d",
+               XmlHelper::CheckNode(rootNodePtr), XmlHelper::HasChild(rootNodePtr));
+        return;
+    }
+    psiTriggers_.clear();
+    for (xmlNodePtr currNode = rootNodePtr->xmlChildrenNode; currNode != nullptr; currNode = currNode->next) {
+        std::map<std::string, std::string> param;
+        XmlHelper::GetModuleParam(currNode, param);
+        if (!ParsePsiLevelNode(currNode, param) || psiTriggers_.size() > PSI_MAX_LEVEL_COUNT) {
+            /* if has error, clear list */
+            psiTriggers_.clear();
+            break;
+        }
+    }
+    if (psiTriggers_.empty()) {
+        HILOGE("no valid psi level, use default");
+        SetDefaultConfig();
+    }
+}
+
+bool PsiConfig::ParsePsiLevelNode(const xmlNodePtr &currNodePtr, std::map<std::string, std::string> &param)
+{
+    std::string name = std::string(reinterpret_cast<const char *>(currNodePtr->name));
+    if (name.compare("comment") == 0) {
+        HILOGD("%{public}s comment skip :<%{public}s>", __func__, name.c_str());
+        return true;
+    }
+    if (name.compare("psiLevel") != 0) {
+        HILOGW("%{public}s unknown node :<%{public}s>", __func__, name.c_str());
+        return false;
+    }
+    std::string stallType;
+    unsigned int thresholdMs;
+    unsigned int windowMs;
+    XmlHelper::SetStringParam(param, "stallType", stallType, "some");
+    XmlHelper::SetUnsignedIntParam(param, "thresholdMs", thresholdMs, 0);
+    XmlHelper::SetUnsignedIntParam(param, "windowMs", windowMs, PSI_DEFAULT_WINDOW_MS);
+    if (stallType != "some" && stallType != "full") {
+        HILOGE("node:<%{public}s> invalid stallType:%{public}s", name.c_str(), stallType.c_str());
+        return false;
+    }
+    if (windowMs < PSI_MIN_WINDOW_MS || windowMs > PSI_MAX_WINDOW_MS || thresholdMs == 0 || thresholdMs > windowMs) {
+        HILOGE("node:<%{public}s> <%{public}u, %{public}u> invalid", name.c_str(), thresholdMs, windowMs);
+        return false;
+    }
+    psiTriggers_.push_back({stallType == "full" ? FULL : SOME, thresholdMs, windowMs});
+    return true;
+}
+
+const PsiConfig::PsiTriggerList& PsiConfig::GetPsiTriggers() const
+{
+    return psiTriggers_;
+}
+
+void PsiConfig::Dump(int fd)
+{
+    dprintf(fd, "PsiConfig:   \n");
+    for (size_t level = 0; level < psiTriggers_.size(); level++) {
+        dprintf(fd, "                   level:%zu  ---->  %s %ums / %ums\n", level,
+            psiTriggers_[level].stallType == FULL ? "full" : "some",
+            psiTriggers_[level].thresholdMs, psiTriggers_[level].windowMs);
+    }
+}
+} // namespace Memory
+} // namespace OHOS
@@ -12,6 +12,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+
 #include "memmgr_log.h"
 #include "xml_helper.h"
 #include "reclaim_config.h"
@@ -49,6 +51,16 @@ void ReclaimConfig::ParseConfig(const xmlNodePtr &rootNodePtr)
 
     std::map<std::string, std::string> param;
     for (xmlNodePtr currNode = rootNodePtr->xmlChildrenNode; currNode != nullptr; currNode = currNode->next) {
+        std::string name = XmlHelper::CheckNode(currNode) ?
+            std::string(reinterpret_cast<const char *>(currNode->name)) : "";
+        if (name.compare("memcgStatsSampler") == 0) {
+            ParseMemcgStatsSamplerConfig(currNode);
+            continue;
+        }
+        if (name.compare("reclaimRatioController") == 0) {
+            ParseRatioControllerConfig(currNode);
+            continue;
+        }
         if (!XmlHelper::GetModuleParam(currNode, param)) {
             HILOGW("Get moudle param failed.");
             return;
@@ -123,6 +135,75 @@ void ReclaimConfig::CheckZswapdParam(std::shared_ptr<ZswapdParam> zswapdParam)
     zswapdParam->SetRefaultThreshold(refaultThreshold);
 }
 
+void ReclaimConfig::ParseMemcgStatsSamplerConfig(const xmlNodePtr &rootNodePtr)
+{
+    if (!XmlHelper::HasChild(rootNodePtr)) {
+        return;
+    }
+    std::map<std::string, std::string> param;
+    if (!XmlHelper::GetModuleParam(rootNodePtr, param)) {
+        HILOGW("Get moudle param failed.");
+        return;
+    }
+    unsigned int periodMs;
+    unsigned int sampleCount;
+    XmlHelper::SetUnsignedIntParam(param, "periodMs", periodMs, MEMCG_STATS_SAMPLE_PERIOD_MS);
+    XmlHelper::SetUnsignedIntParam(param, "sampleCount", sampleCount, MEMCG_STATS_SAMPLE_COUNT);
+    if (periodMs != 0 && periodMs < MEMCG_STATS_MIN_SAMPLE_PERIOD_MS) {
+        periodMs = MEMCG_STATS_MIN_SAMPLE_PERIOD_MS;
+    }
+    if (sampleCount == 0 || sampleCount > MEMCG_STATS_MAX_SAMPLE_COUNT) {
+        sampleCount = MEMCG_STATS_SAMPLE_COUNT;
+    }
+    statsSamplePeriodMs_ = periodMs;
+    statsSampleCount_ = sampleCount;
+}
+
+unsigned int ReclaimConfig::GetStatsSamplePeriodMs() const
+{
+    return statsSamplePeriodMs_;
+}
+
+unsigned int ReclaimConfig::GetStatsSampleCount() const
+{
+    return statsSampleCount_;
+}
+
+void ReclaimConfig::ParseRatioControllerConfig(const xmlNodePtr &rootNodePtr)
+{
+    if (!XmlHelper::HasChild(rootNodePtr)) {
+        return;
+    }
+    std::map<std::string, std::string> param;
+    if (!XmlHelper::GetModuleParam(rootNodePtr, param)) {
+        HILOGW("Get moudle param failed.");
+        return;
+    }
+    RatioControllerConfig config;
+    XmlHelper::SetUnsignedIntParam(param, "maxOffset", config.maxOffset, RATIO_CONTROLLER_MAX_OFFSET);
+    XmlHelper::SetUnsignedIntParam(param, "step", config.step, RATIO_CONTROLLER_STEP);
+    XmlHelper::SetUnsignedIntParam(param, "refaultHigh", config.refaultHigh, RATIO_CONTROLLER_REFAULT_HIGH);
+    XmlHelper::SetUnsignedIntParam(param, "refaultLow", config.refaultLow, RATIO_CONTROLLER_REFAULT_LOW);
+    if (config.maxOffset > MAX_UNINTPARAM) {
+        config.maxOffset = MAX_UNINTPARAM;
+    }
+    if (config.step == 0 || config.step > config.maxOffset) {
+        config.step = std::min(RATIO_CONTROLLER_STEP, config.maxOffset);
+    }
+    if (config.refaultLow >= config.refaultHigh) {
+        HILOGE("refaultLow %{public}u is not less than refaultHigh %{public}u, use default",
+            config.refaultLow, config.refaultHigh);
+        config.refaultHigh = RATIO_CONTROLLER_REFAULT_HIGH;
+        config.refaultLow = RATIO_CONTROLLER_REFAULT_LOW;
+    }
+    ratioControllerConfig_ = config;
+}
+
+const RatioControllerConfig& ReclaimConfig::GetRatioControllerConfig() const
+{
+    return ratioControllerConfig_;
+}
+
 void ReclaimConfig::AddReclaimConfigToSet(std::shared_ptr<ZswapdParam> zswapdParam)
 {
     reclaimConfigSet_.insert(zswapdParam);
@@ -214,6 +295,10 @@ void ReclaimConfig::Dump(int fd)
         dprintf(fd, "                 zram2ufsRatio: %u\n", (*it)->GetZram2ufsRatio());
         dprintf(fd, "              refaultThreshold: %u\n", (*it)->GetRefaultThreshold());
     }
+    dprintf(fd, "memcg stats sampler: period %ums, %u samples\n", statsSamplePeriodMs_, statsSampleCount_);
+    dprintf(fd, "reclaim ratio controller: max offset %u, step %u, refaults per second low %u high %u\n",
+        ratioControllerConfig_.maxOffset, ratioControllerConfig_.step, ratioControllerConfig_.refaultLow,
+        ratioControllerConfig_.refaultHigh);
 }
 } // namespace Memory
 } // namespace OHOS
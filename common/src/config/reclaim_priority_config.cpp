@@ -24,6 +24,7 @@ namespace OHOS {
 namespace Memory {
 namespace {
     const std::string TAG = "ReclaimPriorityConfig";
+    const unsigned long long MAX_UPDATE_COALESCE_WINDOW_MS = 1000;
 }
 
 void ReclaimPriorityConfig::ParseConfig(const xmlNodePtr &rootNodePtr)
@@ -46,6 +47,16 @@ void ReclaimPriorityConfig::ParseConfig(const xmlNodePtr &rootNodePtr)
             ParseReclaimPriorityImportantBgAppsConfig(currNode);
             continue;
         }
+        if (name.compare("updateCoalesceWindowMs") == 0) {
+            unsigned long long windowMs = 0;
+            if (!XmlHelper::ParseUnsignedLongLongContent(currNode, windowMs) ||
+                windowMs > MAX_UPDATE_COALESCE_WINDOW_MS) {
+                HILOGE("parse key :<%{public}s> error", name.c_str());
+                continue;
+            }
+            updateCoalesceWindowMs_ = static_cast<unsigned int>(windowMs);
+            continue;
+        }
         HILOGW("unknown node :<%{public}s>", name.c_str());
         return;
     }
@@ -129,12 +140,18 @@ std::map<std::string, int> ReclaimPriorityConfig::GetImportantBgApps()
     return importantBgApps_;
 }
 
+unsigned int ReclaimPriorityConfig::GetUpdateCoalesceWindowMs()
+{
+    return updateCoalesceWindowMs_;
+}
+
 void ReclaimPriorityConfig::Dump(int fd)
 {
     dprintf(fd, "ImportantBgApps:   \n");
     for (auto it = importantBgApps_.begin(); it != importantBgApps_.end(); it++) {
         dprintf(fd, "              procName:%s  ---->  prio:%d \n", it->first.c_str(), it->second);
     }
+    dprintf(fd, "UpdateCoalesceWindowMs: %u\n", updateCoalesceWindowMs_);
 }
 } // namespace Memory
 } // namespace OHOS
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "epoll_reactor.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "memmgr_log.h"
+#include "memmgr_ptr_util.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "EpollReactor";
+const int MAX_EPOLL_EVENTS = 32;
+}
+
+IMPLEMENT_SINGLE_INSTANCE(EpollReactor);
+
+EpollReactor::EpollReactor()
+{
+}
+
+EpollReactor::~EpollReactor()
+{
+    if (epollfd_ >= 0) {
+        close(epollfd_);
+    }
+}
+
+bool EpollReactor::StartLocked()
+{
+    if (started_) {
+        return true;
+    }
+    if (epollfd_ < 0) {
+        epollfd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epollfd_ < 0) {
+            HILOGE("epoll_create failed (errno=%{public}d)", errno);
+            return false;
+        }
+    }
+    if (handler_ == nullptr) {
+        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
+            AppExecFwk::EventRunner::Create());
+    }
+    // MainLoop occupies the handler thread, it is the only thread blocked in epoll_wait
+    if (!handler_->PostImmediateTask([this] { this->MainLoop(); })) {
+        HILOGE("failed to post MainLoop");
+        return false;
+    }
+    started_ = true;
+    HILOGI("started, epollfd=%{public}d", epollfd_);
+    return true;
+}
+
+bool EpollReactor::AddFd(int fd, uint32_t events, ReactorPriority priority, const std::string &name,
+    FdHandler handler)
+{
+    if (fd < 0 || handler == nullptr || priority >= ReactorPriority::COUNT) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(watchersLock_);
+    if (fdToId_.find(fd) != fdToId_.end()) {
+        HILOGE("fd=%{public}d of %{public}s is already watched", fd, name.c_str());
+        return false;
+    }
+    if (!StartLocked()) {
+        return false;
+    }
+    auto watcher = std::make_shared<Watcher>();
+    watcher->id = nextId_++;
+    watcher->fd = fd;
+    watcher->events = events;
+    watcher->priority = priority;
+    watcher->name = name;
+    watcher->handler = std::move(handler);
+
+    struct epoll_event epollEvent;
+    epollEvent.events = events;
+    epollEvent.data.u64 = watcher->id;
+    if (epoll_ctl(epollfd_, EPOLL_CTL_ADD, fd, &epollEvent) < 0) {
+        HILOGE("failed to add fd=%{public}d of %{public}s to epoll, errno=%{public}d", fd, name.c_str(), errno);
+        return false;
+    }
+    fdToId_.emplace(fd, watcher->id);
+    watchers_.emplace(watcher->id, watcher);
+    HILOGI("fd=%{public}d of %{public}s is watched", fd, name.c_str());
+    return true;
+}
+
+bool EpollReactor::RemoveFd(int fd)
+{
+    std::lock_guard<std::mutex> lock(watchersLock_);
+    auto it = fdToId_.find(fd);
+    if (it == fdToId_.end()) {
+        return false;
+    }
+    if (epoll_ctl(epollfd_, EPOLL_CTL_DEL, fd, nullptr) < 0) {
+        HILOGE("failed to remove fd=%{public}d from epoll, errno=%{public}d", fd, errno);
+    }
+    watchers_.erase(it->second);
+    fdToId_.erase(it);
+    return true;
+}
+
+bool EpollReactor::IsWatching(int fd)
+{
+    std::lock_guard<std::mutex> lock(watchersLock_);
+    return fdToId_.find(fd) != fdToId_.end();
+}
+
+size_t EpollReactor::Size()
+{
+    std::lock_guard<std::mutex> lock(watchersLock_);
+    return watchers_.size();
+}
+
+void EpollReactor::MainLoop()
+{
+    HILOGI("enter");
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    while (true) {
+        int nevents = epoll_wait(epollfd_, events, MAX_EPOLL_EVENTS, -1);
+        if (nevents < 0) {
+            if (errno != EINTR) {
+                HILOGE("failed to wait epoll event(errno=%{public}d)", errno);
+            }
+            continue;
+        }
+        loops_.fetch_add(1, std::memory_order_relaxed);
+        DispatchEvents(events, nevents);
+    }
+}
+
+void EpollReactor::DispatchEvents(struct epoll_event *events, int count)
+{
+    using Ready = std::pair<std::shared_ptr<Watcher>, uint32_t>;
+    std::vector<Ready> ready[static_cast<int>(ReactorPriority::COUNT)];
+    {
+        std::lock_guard<std::mutex> lock(watchersLock_);
+        for (int i = 0; i < count; i++) {
+            // copy out fields, epoll_event may be packed
+            uint64_t id = events[i].data.u64;
+            uint32_t revents = events[i].events;
+            auto it = watchers_.find(id);
+            if (it == watchers_.end()) {
+                continue; // removed after epoll_wait returned
+            }
+            ready[static_cast<int>(it->second->priority)].emplace_back(it->second, revents);
+        }
+    }
+    for (auto &readyOfPrio : ready) {
+        for (auto &item : readyOfPrio) {
+            if (!IsRegistered(item.first)) {
+                // removed by an earlier handler of this batch, its fd may be closed and reused
+                continue;
+            }
+            item.first->dispatched.fetch_add(1, std::memory_order_relaxed);
+            item.first->handler(item.first->fd, item.second);
+        }
+    }
+}
+
+bool EpollReactor::IsRegistered(const std::shared_ptr<Watcher> &watcher)
+{
+    std::lock_guard<std::mutex> lock(watchersLock_);
+    auto it = watchers_.find(watcher->id);
+    return it != watchers_.end() && it->second == watcher;
+}
+
+void EpollReactor::Dump(int fd)
+{
+    std::lock_guard<std::mutex> lock(watchersLock_);
+    dprintf(fd, "epoll reactor: %zu fds, %llu wakeups\n", watchers_.size(),
+        static_cast<unsigned long long>(loops_.load(std::memory_order_relaxed)));
+    dprintf(fd, "                          name     fd priority   dispatched\n");
+    for (auto &pair : watchers_) {
+        auto &watcher = pair.second;
+        dprintf(fd, "%30s %6d %8d %12llu\n", watcher->name.c_str(), watcher->fd,
+            static_cast<int>(watcher->priority),
+            static_cast<unsigned long long>(watcher->dispatched.load(std::memory_order_relaxed)));
+    }
+}
+} // namespace Memory
+} // namespace OHOS
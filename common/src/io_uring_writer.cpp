@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_uring_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(USE_IO_URING) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define MEMMGR_IO_URING_ENABLED
+#endif
+#endif
+
+#include "memmgr_log.h"
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "IoUringWriter";
+#ifdef MEMMGR_IO_URING_ENABLED
+const unsigned int RING_ENTRIES = 64;
+// io_uring_enter interrupted or busy, retried with backoff before the batch falls back to write
+const int MAX_ENTER_RETRIES = 5;
+const unsigned int ENTER_RETRY_BACKOFF_US = 100;
+#endif
+}
+
+IoUringWriter::~IoUringWriter()
+{
+    Teardown();
+}
+
+bool IoUringWriter::IsAvailable()
+{
+    if (!setupTried_) {
+        setupTried_ = true;
+        if (!Setup()) {
+            Teardown();
+        }
+    }
+    return ringFd_ >= 0;
+}
+
+void IoUringWriter::Teardown()
+{
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqesSize_);
+        sqes_ = nullptr;
+    }
+    if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+        munmap(cqRing_, cqRingSize_);
+    }
+    cqRing_ = nullptr;
+    if (sqRing_ != nullptr) {
+        munmap(sqRing_, sqRingSize_);
+        sqRing_ = nullptr;
+    }
+    if (ringFd_ >= 0) {
+        close(ringFd_);
+        ringFd_ = -1;
+    }
+}
+
+#ifdef MEMMGR_IO_URING_ENABLED
+namespace {
+template<typename T>
+T *RingField(void *ring, uint32_t offset)
+{
+    return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+}
+
+bool IoUringWriter::Setup()
+{
+    struct io_uring_params params = {};
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, RING_ENTRIES, &params));
+    if (fd < 0) {
+        HILOGI("io_uring is not available, errno=%{public}d", errno);
+        return false;
+    }
+    ringFd_ = fd;
+    // writes at the current position of fds need 5.6 or later, the same as IORING_OP_WRITE
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+        HILOGI("io_uring is too old to write at current position");
+        return false;
+    }
+    sqEntries_ = params.sq_entries;
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        sqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+        cqRingSize_ = sqRingSize_;
+    }
+    void *ptr = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ptr == MAP_FAILED) {
+        HILOGE("mmap sq ring failed, errno=%{public}d", errno);
+        return false;
+    }
+    sqRing_ = ptr;
+    if (singleMmap) {
+        cqRing_ = sqRing_;
+    } else {
+        ptr = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ptr == MAP_FAILED) {
+            HILOGE("mmap cq ring failed, errno=%{public}d", errno);
+            return false;
+        }
+        cqRing_ = ptr;
+    }
+    sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    ptr = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ptr == MAP_FAILED) {
+        HILOGE("mmap sqes failed, errno=%{public}d", errno);
+        return false;
+    }
+    sqes_ = ptr;
+    sqHead_ = RingField<unsigned int>(sqRing_, params.sq_off.head);
+    sqTail_ = RingField<unsigned int>(sqRing_, params.sq_off.tail);
+    sqMask_ = RingField<unsigned int>(sqRing_, params.sq_off.ring_mask);
+    sqArray_ = RingField<unsigned int>(sqRing_, params.sq_off.array);
+    cqHead_ = RingField<unsigned int>(cqRing_, params.cq_off.head);
+    cqTail_ = RingField<unsigned int>(cqRing_, params.cq_off.tail);
+    cqMask_ = RingField<unsigned int>(cqRing_, params.cq_off.ring_mask);
+    cqes_ = RingField<void>(cqRing_, params.cq_off.cqes);
+    HILOGI("io_uring is set up, %{public}u entries", sqEntries_);
+    return true;
+}
+
+size_t IoUringWriter::ReapCompletions(std::vector<WriteRequest> &requests, size_t begin)
+{
+    size_t reaped = 0;
+    unsigned int head = *cqHead_;
+    unsigned int tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    auto cqes = static_cast<struct io_uring_cqe *>(cqes_);
+    while (head != tail) {
+        struct io_uring_cqe &cqe = cqes[head & *cqMask_];
+        size_t index = begin + static_cast<size_t>(cqe.user_data);
+        if (index < requests.size()) {
+            requests[index].res = cqe.res;
+            requests[index].done = true;
+        }
+        head++;
+        reaped++;
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+bool IoUringWriter::SubmitAndWait(std::vector<WriteRequest> &requests, size_t begin, size_t count)
+{
+    auto sqes = static_cast<struct io_uring_sqe *>(sqes_);
+    unsigned int tail = *sqTail_;
+    for (size_t i = 0; i < count; i++) {
+        const WriteRequest &request = requests[begin + i];
+        unsigned int index = (tail + i) & *sqMask_;
+        struct io_uring_sqe &sqe = sqes[index];
+        sqe = {};
+        sqe.opcode = IORING_OP_WRITE;
+        sqe.fd = request.fd;
+        sqe.addr = reinterpret_cast<uint64_t>(request.buf);
+        sqe.len = static_cast<uint32_t>(request.len);
+        sqe.off = static_cast<uint64_t>(-1); // current position, the same as write
+        sqe.user_data = i;
+        sqArray_[index] = index;
+    }
+    unsigned int newTail = tail + static_cast<unsigned int>(count);
+    __atomic_store_n(sqTail_, newTail, __ATOMIC_RELEASE);
+
+    size_t completed = 0;
+    int retries = 0;
+    while (completed < count) {
+        unsigned int toSubmit = newTail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        long ret = syscall(__NR_io_uring_enter, ringFd_, toSubmit, static_cast<unsigned int>(count - completed),
+            IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (ret < 0) {
+            int err = errno;
+            if ((err != EINTR && err != EAGAIN) || retries >= MAX_ENTER_RETRIES) {
+                HILOGE("io_uring_enter failed, errno=%{public}d, %{public}d retries", err, retries);
+                completed += ReapCompletions(requests, begin);
+                // sqes consumed by the kernel may still be written by io-wq workers, wait for them
+                // before callers free the buffers or write the requests not done again
+                size_t submitted = static_cast<size_t>(__atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) - tail);
+                WaitSubmitted(requests, begin, submitted, completed);
+                return false;
+            }
+            usleep(ENTER_RETRY_BACKOFF_US << retries);
+            retries++;
+        }
+        completed += ReapCompletions(requests, begin);
+    }
+    return true;
+}
+
+void IoUringWriter::WaitSubmitted(std::vector<WriteRequest> &requests, size_t begin, size_t submitted,
+    size_t completed)
+{
+    while (completed < submitted) {
+        long ret = syscall(__NR_io_uring_enter, ringFd_, 0, static_cast<unsigned int>(submitted - completed),
+            IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (ret < 0) {
+            usleep(ENTER_RETRY_BACKOFF_US); // completions are posted without enter, poll them
+        }
+        completed += ReapCompletions(requests, begin);
+    }
+}
+
+bool IoUringWriter::Write(std::vector<WriteRequest> &requests)
+{
+    if (!IsAvailable()) {
+        return false;
+    }
+    for (size_t begin = 0; begin < requests.size(); begin += sqEntries_) {
+        size_t count = std::min(static_cast<size_t>(sqEntries_), requests.size() - begin);
+        if (!SubmitAndWait(requests, begin, count)) {
+            // the state of ring is unknown, never use it again
+            Teardown();
+            return false;
+        }
+    }
+    return true;
+}
+#else
+bool IoUringWriter::Setup()
+{
+    return false;
+}
+
+bool IoUringWriter::Write(std::vector<WriteRequest> &)
+{
+    return false;
+}
+#endif // MEMMGR_IO_URING_ENABLED
+} // namespace Memory
+} // namespace OHOS
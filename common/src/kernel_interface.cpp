@@ -19,16 +19,26 @@
 #include <csignal>
 #include <dirent.h>
 #include <fstream>
-#include <regex>
 #include <securec.h>
 #include <sstream>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include "directory_ex.h"
 #include "file_ex.h"
 #include "memmgr_log.h"
 
+#ifndef __NR_pidfd_send_signal
+#define __NR_pidfd_send_signal 424
+#endif
+#ifndef __NR_pidfd_open
+#define __NR_pidfd_open 434
+#endif
+#ifndef __NR_process_mrelease
+#define __NR_process_mrelease 448
+#endif
+
 namespace OHOS {
 namespace Memory {
 namespace {
@@ -149,6 +159,72 @@ bool KernelInterface::WriteToFile(const std::string& path, const std::string& co
     return true;
 }
 
+int KernelInterface::BatchWrite(std::vector<BatchWriteEntry>& entries)
+{
+    std::vector<WriteRequest> requests;
+    std::vector<size_t> requestToEntry;
+    std::vector<int> openedFds;
+    requests.reserve(entries.size());
+    requestToEntry.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        BatchWriteEntry &entry = entries[i];
+        entry.error = 0;
+        int fd = entry.fd;
+        if (fd < 0) {
+            fd = open(entry.path.c_str(), O_WRONLY | O_CLOEXEC);
+            if (fd < 0) {
+                entry.error = errno;
+                HILOGD("open %{public}s failed, errno=%{public}d", entry.path.c_str(), errno);
+                continue;
+            }
+            openedFds.push_back(fd);
+        }
+        WriteRequest request;
+        request.fd = fd;
+        request.buf = entry.content.c_str();
+        request.len = entry.content.size();
+        requests.push_back(request);
+        requestToEntry.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(batchWriteLock_);
+        ioUringWriter_.Write(requests);
+    }
+    int written = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        WriteRequest &request = requests[i];
+        if (!request.done) { // io_uring is not available, or broken before it is done
+            ssize_t ret;
+            do {
+                ret = write(request.fd, request.buf, request.len);
+            } while (ret < 0 && errno == EINTR);
+            request.res = (ret < 0) ? -errno : static_cast<int>(ret);
+        }
+        BatchWriteEntry &entry = entries[requestToEntry[i]];
+        if (request.res < 0) {
+            entry.error = -request.res;
+        } else if (static_cast<size_t>(request.res) != request.len) {
+            entry.error = EIO;
+        } else {
+            written++;
+            continue;
+        }
+        HILOGD("write %{public}s to fd=%{public}d %{public}s failed, errno=%{public}d", entry.content.c_str(),
+            request.fd, entry.path.c_str(), entry.error);
+    }
+    for (int fd : openedFds) {
+        close(fd);
+    }
+    return written;
+}
+
+bool KernelInterface::IsBatchWriteAccelerated()
+{
+    std::lock_guard<std::mutex> lock(batchWriteLock_);
+    return ioUringWriter_.IsAvailable();
+}
+
 bool KernelInterface::ReadFromFile(const std::string& path, std::string& content)
 {
     return OHOS::LoadStringFromFile(path, content);
@@ -357,19 +433,19 @@ void KernelInterface::ReadZswapdPressureShow(std::map<std::string, std::string>&
 
 int KernelInterface::GetCurrentBuffer()
 {
-    std::map<std::string, std::string> result;
-    ReadZswapdPressureShow(result);
-    auto value = result.find(ZWAPD_PRESSURE_SHOW_BUFFER_SIZE);
-    if (value != result.end()) {
+    const char *keys[] = { ZWAPD_PRESSURE_SHOW_BUFFER_SIZE.c_str() };
+    long long value = 0;
+    if (bufferReader_.ReadValues(keys, &value, 1) != 1) {
+        HILOGE("read %{public}s from %{public}s failed", keys[0], ZWAPD_PRESSURE_SHOW_PATH.c_str());
+        return MAX_BUFFER_KB;
+    }
 #ifdef USE_HYPERHOLD_MEMORY
-        HILOGD("buffer_size=%{public}s MB", result[ZWAPD_PRESSURE_SHOW_BUFFER_SIZE].c_str());
-        return atoi(result[ZWAPD_PRESSURE_SHOW_BUFFER_SIZE].c_str()) * KB_PER_MB;
+    HILOGD("buffer_size=%{public}lld MB", value);
+    return static_cast<int>(value * KB_PER_MB);
 #else
-        HILOGD("buffer_size=%{public}s KB", result[ZWAPD_PRESSURE_SHOW_BUFFER_SIZE].c_str());
-        return atoi(result[ZWAPD_PRESSURE_SHOW_BUFFER_SIZE].c_str());
+    HILOGD("buffer_size=%{public}lld KB", value);
+    return static_cast<int>(value);
 #endif
-    }
-    return MAX_BUFFER_KB;
 }
 
 int KernelInterface::KillOneProcessByPid(int pid)
@@ -400,6 +476,21 @@ out:
     return freedBuffer;
 }
 
+int KernelInterface::PidfdOpen(pid_t pid)
+{
+    return static_cast<int>(syscall(__NR_pidfd_open, pid, 0));
+}
+
+bool KernelInterface::PidfdSendSignal(int pidfd, int sig)
+{
+    return syscall(__NR_pidfd_send_signal, pidfd, sig, nullptr, 0) == 0;
+}
+
+bool KernelInterface::ProcessMrelease(int pidfd)
+{
+    return syscall(__NR_process_mrelease, pidfd, 0) == 0;
+}
+
 bool KernelInterface::GetAllProcPids(std::vector<unsigned int> &pids)
 {
     pids.clear();
@@ -429,25 +520,73 @@ bool KernelInterface::GetAllProcPids(std::vector<unsigned int> &pids)
 
 bool KernelInterface::GetUidByPid(unsigned int pid, unsigned int& uid)
 {
-    std::string path = JoinPath(ROOT_PROC_PATH, std::to_string(pid), "status");
-    std::string content;
-    if (!ReadFromFile(path, content)) {
-        HILOGE("read file failed. %{public}s", path.c_str());
+    ProcStatus status;
+    if (!GetProcStatusByPid(pid, status)) {
         return false;
     }
-    content = std::regex_replace(content, std::regex("\n+"), " "); // replace \n with space
-    std::regex re(".*Uid:[[:s:]]*([[:d:]]+)[[:s:]]*([[:d:]]+)[[:s:]]*([[:d:]]+)[[:s:]]*([[:d:]]+).*");
-    std::smatch res;
-    if (!std::regex_match(content, res, re)) {
-        HILOGD("re not match. %{public}s", content.c_str());
+    uid = status.uid;
+    return true;
+}
+
+bool KernelInterface::GetProcStatusByPid(unsigned int pid, ProcStatus &status)
+{
+    std::string path = ROOT_PROC_PATH + "/" + std::to_string(pid) + "/" + FILE_PROC_STATUS;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        HILOGD("open %{public}s failed", path.c_str());
         return false;
     }
-    try {
-        uid = (unsigned int)std::stoi(res.str(1)); // 1: Uid index
-    } catch (...) {
-        HILOGE("stoi(%{public}s) failed", res.str(1).c_str());
+    // Name, Tgid and Uid are all in the first lines of status, no need to read the whole file
+    char buf[PROC_STATUS_READ_SIZE];
+    ssize_t len = read(fd, buf, sizeof(buf));
+    close(fd);
+    if (len <= 0) {
+        HILOGD("read %{public}s failed", path.c_str());
+        return false;
+    }
+    const char *keys[] = { "Tgid", "Uid" };
+    long long values[] = { 0, 0 };
+    if (KvFileReader::ParseValues(buf, static_cast<size_t>(len), keys, values, 2) != 2) { // 2: Tgid and Uid
+        HILOGD("parse %{public}s failed", path.c_str());
+        return false;
+    }
+    status.pid = pid;
+    status.tgid = static_cast<unsigned int>(values[0]);
+    status.uid = static_cast<unsigned int>(values[1]);
+    status.name.clear();
+    // first line is "Name:\t<name>"
+    const char namePrefix[] = "Name:";
+    size_t prefixLen = sizeof(namePrefix) - 1;
+    if (static_cast<size_t>(len) > prefixLen && strncmp(buf, namePrefix, prefixLen) == 0) {
+        size_t begin = prefixLen;
+        while (begin < static_cast<size_t>(len) && (buf[begin] == ' ' || buf[begin] == '\t')) {
+            begin++;
+        }
+        size_t end = begin;
+        while (end < static_cast<size_t>(len) && buf[end] != '\n') {
+            end++;
+        }
+        status.name.assign(buf + begin, end - begin);
+    }
+    return true;
+}
+
+bool KernelInterface::GetAllProcStatus(std::vector<ProcStatus> &statusList)
+{
+    statusList.clear();
+    std::vector<unsigned int> pids;
+    if (!GetAllProcPids(pids)) {
         return false;
     }
+    statusList.reserve(pids.size());
+    ProcStatus status;
+    for (unsigned int pid : pids) {
+        // process may exit during iteration, just skip it
+        if (GetProcStatusByPid(pid, status)) {
+            statusList.push_back(status);
+        }
+    }
+    HILOGD("get status of %{public}zu/%{public}zu procs", statusList.size(), pids.size());
     return true;
 }
 
@@ -514,67 +653,19 @@ bool KernelInterface::ReadSwapOutKBSinceKernelBoot(const std::string &path, cons
     return success;
 }
 
-int KernelInterface::ParseMeminfo(const std::string &contentStr, const std::string &itemName)
-{
-    char *contentPtr = new (std::nothrow) char[contentStr.size() + 1];
-    if (contentPtr == nullptr) {
-        HILOGE("alloc buffer fail");
-        return -1;
-    }
-    if (strcpy_s(contentPtr, contentStr.size() + 1, contentStr.c_str()) != EOK) {
-        HILOGE("copy fail");
-        delete [] contentPtr;
-        return -1;
-    }
-    char *restPtr = nullptr;
-    char *line = strtok_r(contentPtr, "\n", &restPtr);
-    std::string name;
-    std::string value;
-    bool findTotalMem = false;
-    do {
-        for (size_t i = 0; i < strlen(line); i++) {
-            if (line[i] == ':') {
-                line[i] = ' ';
-            }
-        }
-        std::string lineStr(line);
-        std::istringstream is(lineStr);
-
-        is >> name >> value;
-        if (name == itemName) {
-            findTotalMem = true;
-            break;
-        }
-        line = strtok_r(NULL, "\n", &restPtr);
-    } while (line);
-    if (contentPtr) {
-        delete [] contentPtr;
-    }
-
-    if (findTotalMem == false) {
-        return -1;
-    }
-    std::string valueTemp = "";
-    for (auto c : value) {
-        if (c >= '0' && c <= '9') {
-            valueTemp = valueTemp + c;
-        }
-    }
-    return atoi(valueTemp.c_str());
-}
-
 int KernelInterface::GetTotalBuffer()
 {
     if (totalBuffer_ >= 0) {
         return totalBuffer_;
     }
 
-    std::string contentStr;
-    if (!ReadFromFile(MEMINFO_PATH, contentStr)) {
-        HILOGE("read %{public}s faild, content=[%{public}s]", MEMINFO_PATH.c_str(), contentStr.c_str());
+    const char *keys[] = { TOTAL_MEMORY.c_str() };
+    long long value = 0;
+    if (meminfoReader_.ReadValues(keys, &value, 1) != 1) {
+        HILOGE("read %{public}s from %{public}s failed", keys[0], MEMINFO_PATH.c_str());
         return -1;
     }
-    totalBuffer_ = ParseMeminfo(contentStr, TOTAL_MEMORY);
+    totalBuffer_ = static_cast<int>(value);
     return totalBuffer_;
 }
 
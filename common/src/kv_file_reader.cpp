@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kv_file_reader.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "memmgr_log.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "KvFileReader";
+
+inline bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+} // namespace
+
+KvFileReader::KvFileReader(const std::string &path) : path_(path), fd_(-1)
+{
+}
+
+KvFileReader::~KvFileReader()
+{
+    CloseFd();
+}
+
+const std::string& KvFileReader::GetPath() const
+{
+    return path_;
+}
+
+int KvFileReader::GetFd()
+{
+    int fd = fd_.load(std::memory_order_acquire);
+    if (fd >= 0) {
+        return fd;
+    }
+    std::lock_guard<std::mutex> lock(fdLock_);
+    fd = fd_.load(std::memory_order_relaxed);
+    if (fd >= 0) {
+        return fd;
+    }
+    fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        HILOGE("open %{public}s failed, errno=%{public}d", path_.c_str(), errno);
+        return -1;
+    }
+    fd_.store(fd, std::memory_order_release);
+    return fd;
+}
+
+void KvFileReader::CloseFd()
+{
+    std::lock_guard<std::mutex> lock(fdLock_);
+    int fd = fd_.exchange(-1);
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+int KvFileReader::ReadValues(const char * const keys[], long long values[], int count)
+{
+    int fd = GetFd();
+    if (fd < 0) {
+        return -1;
+    }
+    char buf[KV_FILE_READ_BUF_SIZE];
+    ssize_t len;
+    do {
+        len = pread(fd, buf, sizeof(buf), 0);
+    } while (len < 0 && errno == EINTR);
+    if (len < 0) {
+        HILOGE("pread %{public}s failed, errno=%{public}d", path_.c_str(), errno);
+        // the fd may be stale, e.g. memcg removed and recreated, reopen it at next read
+        CloseFd();
+        return -1;
+    }
+    size_t validLen = static_cast<size_t>(len);
+    if (validLen == sizeof(buf)) {
+        // content is truncated, drop the last incomplete line
+        while (validLen > 0 && buf[validLen - 1] != '\n') {
+            validLen--;
+        }
+    }
+    return ParseValues(buf, validLen, keys, values, count);
+}
+
+int KvFileReader::ParseValues(const char *buf, size_t len, const char * const keys[], long long values[], int count)
+{
+    if (buf == nullptr || keys == nullptr || values == nullptr || count <= 0 || count > KV_FILE_MAX_KEYS) {
+        return 0;
+    }
+    uint64_t foundMask = 0;
+    int found = 0;
+    size_t pos = 0;
+    while (pos < len && found < count) {
+        size_t lineEnd = pos;
+        while (lineEnd < len && buf[lineEnd] != '\n') {
+            lineEnd++;
+        }
+        // name ends with ':' or blank
+        size_t nameEnd = pos;
+        while (nameEnd < lineEnd && buf[nameEnd] != ':' && !IsBlank(buf[nameEnd])) {
+            nameEnd++;
+        }
+        size_t nameLen = nameEnd - pos;
+        for (int i = 0; nameLen > 0 && i < count; i++) {
+            if ((foundMask & (1ULL << i)) || strncmp(buf + pos, keys[i], nameLen) != 0 ||
+                keys[i][nameLen] != '\0') {
+                continue;
+            }
+            size_t cur = nameEnd;
+            while (cur < lineEnd && (buf[cur] == ':' || IsBlank(buf[cur]))) {
+                cur++;
+            }
+            bool negative = false;
+            if (cur < lineEnd && buf[cur] == '-') {
+                negative = true;
+                cur++;
+            }
+            if (cur >= lineEnd || !IsDigit(buf[cur])) {
+                break;
+            }
+            long long value = 0;
+            while (cur < lineEnd && IsDigit(buf[cur])) {
+                value = value * 10 + (buf[cur] - '0'); // 10: decimal
+                cur++;
+            }
+            values[i] = negative ? -value : value;
+            foundMask |= (1ULL << i);
+            found++;
+            break;
+        }
+        pos = lineEnd + 1;
+    }
+    return found;
+}
+} // namespace Memory
+} // namespace OHOS
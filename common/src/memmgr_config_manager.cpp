@@ -126,6 +126,10 @@ bool MemmgrConfigManager::ParseXmlRootNode(const xmlNodePtr &rootNodePtr)
             purgeablememConfig_.ParseConfig(currNode);
             continue;
         }
+        if (name.compare("psiConfig") == 0) {
+            psiConfig_.ParseConfig(currNode);
+            continue;
+        }
         HILOGW("unknown node :<%{public}s>", name.c_str());
         return false;
     }
@@ -186,6 +190,11 @@ const ReclaimConfig::ReclaimConfigSet& MemmgrConfigManager::GetReclaimConfigSet(
     return reclaimConfig_.GetReclaimConfigSet();
 }
 
+const ReclaimConfig& MemmgrConfigManager::GetReclaimConfig()
+{
+    return reclaimConfig_;
+}
+
 const KillConfig& MemmgrConfigManager::GetKillConfig()
 {
     return killConfig_;
@@ -201,6 +210,11 @@ const PurgeablememConfig& MemmgrConfigManager::GetPurgeablememConfig()
     return purgeablememConfig_;
 }
 
+const PsiConfig& MemmgrConfigManager::GetPsiConfig()
+{
+    return psiConfig_;
+}
+
 void MemmgrConfigManager::Dump(int fd)
 {
     availBufferConfig_.Dump(fd);
@@ -211,6 +225,7 @@ void MemmgrConfigManager::Dump(int fd)
     switchConfig_.Dump(fd);
     reclaimPriorityConfig_.Dump(fd);
     purgeablememConfig_.Dump(fd);
+    psiConfig_.Dump(fd);
 }
 } // namespace Memory
 } // namespace OHOS
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memmgr_executor.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include "memmgr_log.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "MemMgrExecutor";
+
+void UpdateMax(std::atomic<int64_t> &target, int64_t value)
+{
+    int64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+/*
+ * Travels with a posted task. It is destroyed without being started if the task is removed
+ * or failed to post, so the depth of lane is always balanced.
+ */
+class TaskToken {
+public:
+    TaskToken(LaneCounters *counters, int64_t delayTime)
+        : counters_(counters),
+          due_(std::chrono::steady_clock::now() + std::chrono::milliseconds(delayTime > 0 ? delayTime : 0))
+    {
+        counters_->posted.fetch_add(1, std::memory_order_relaxed);
+        UpdateMax(counters_->maxDepth, counters_->depth.fetch_add(1, std::memory_order_relaxed) + 1);
+    }
+
+    ~TaskToken()
+    {
+        if (!started_.load(std::memory_order_relaxed)) {
+            counters_->cancelled.fetch_add(1, std::memory_order_relaxed);
+            counters_->depth.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void Start()
+    {
+        if (started_.exchange(true, std::memory_order_relaxed)) {
+            return;
+        }
+        counters_->depth.fetch_sub(1, std::memory_order_relaxed);
+        counters_->executed.fetch_add(1, std::memory_order_relaxed);
+        int64_t latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - due_).count();
+        UpdateMax(counters_->maxLatencyMs, latencyMs);
+    }
+
+private:
+    LaneCounters *counters_;
+    std::chrono::steady_clock::time_point due_;
+    std::atomic<bool> started_ {false};
+};
+} // namespace
+
+LaneHandler::LaneHandler(ExecutorLane lane) : lane_(lane)
+{
+    counters_ = MemMgrExecutor::GetInstance().GetCounters(lane);
+    auto runner = MemMgrExecutor::GetInstance().GetRunner(lane);
+    if (counters_ == nullptr || runner == nullptr) {
+        HILOGE("lane %{public}d is not available", static_cast<int>(lane));
+        return;
+    }
+    handler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+}
+
+LaneHandler::Callback LaneHandler::Wrap(const Callback &callback, int64_t delayTime)
+{
+    auto token = std::make_shared<TaskToken>(counters_, delayTime);
+    return [callback, token] {
+        token->Start();
+        callback();
+    };
+}
+
+bool LaneHandler::PostTask(const Callback &callback, int64_t delayTime, Priority priority)
+{
+    if (handler_ == nullptr) {
+        return false;
+    }
+    return handler_->PostTask(Wrap(callback, delayTime), delayTime, priority);
+}
+
+bool LaneHandler::PostTask(const Callback &callback, const std::string &name, int64_t delayTime, Priority priority)
+{
+    if (handler_ == nullptr) {
+        return false;
+    }
+    return handler_->PostTask(Wrap(callback, delayTime), name, delayTime, priority);
+}
+
+bool LaneHandler::PostImmediateTask(const Callback &callback, const std::string &name)
+{
+    if (handler_ == nullptr) {
+        return false;
+    }
+    return handler_->PostImmediateTask(Wrap(callback, 0), name);
+}
+
+bool LaneHandler::PostSyncTask(const Callback &callback, Priority priority)
+{
+    if (handler_ == nullptr) {
+        return false;
+    }
+    return handler_->PostSyncTask(Wrap(callback, 0), priority);
+}
+
+void LaneHandler::RemoveTask(const std::string &name)
+{
+    if (handler_ != nullptr) {
+        handler_->RemoveTask(name);
+    }
+}
+
+ExecutorLane LaneHandler::GetLane() const
+{
+    return lane_;
+}
+
+IMPLEMENT_SINGLE_INSTANCE(MemMgrExecutor);
+
+const char* MemMgrExecutor::GetLaneName(ExecutorLane lane)
+{
+    switch (lane) {
+        case ExecutorLane::KILL:
+            return "Kill";
+        case ExecutorLane::RECLAIM:
+            return "Reclaim";
+        case ExecutorLane::BOOKKEEPING:
+            return "Bookkeeping";
+        case ExecutorLane::TIMER:
+            return "Timer";
+        default:
+            return "Unknown";
+    }
+}
+
+std::shared_ptr<AppExecFwk::EventRunner> MemMgrExecutor::GetRunner(ExecutorLane lane)
+{
+    int index = static_cast<int>(lane);
+    if (index < 0 || index >= LANE_COUNT) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(runnersLock_);
+    if (runners_[index] == nullptr) {
+        runners_[index] = AppExecFwk::EventRunner::Create(std::string("MemMgr") + GetLaneName(lane) + "Lane");
+        HILOGI("runner of lane %{public}s created", GetLaneName(lane));
+    }
+    return runners_[index];
+}
+
+LaneCounters* MemMgrExecutor::GetCounters(ExecutorLane lane)
+{
+    int index = static_cast<int>(lane);
+    if (index < 0 || index >= LANE_COUNT) {
+        return nullptr;
+    }
+    return &counters_[index];
+}
+
+bool MemMgrExecutor::GetLaneStats(ExecutorLane lane, LaneStats &stats)
+{
+    LaneCounters *counters = GetCounters(lane);
+    if (counters == nullptr) {
+        return false;
+    }
+    stats.posted = counters->posted.load(std::memory_order_relaxed);
+    stats.executed = counters->executed.load(std::memory_order_relaxed);
+    stats.cancelled = counters->cancelled.load(std::memory_order_relaxed);
+    stats.depth = counters->depth.load(std::memory_order_relaxed);
+    stats.maxDepth = counters->maxDepth.load(std::memory_order_relaxed);
+    stats.maxLatencyMs = counters->maxLatencyMs.load(std::memory_order_relaxed);
+    return true;
+}
+
+void MemMgrExecutor::Dump(int fd)
+{
+    dprintf(fd, "executor lanes\n");
+    dprintf(fd, "       lane       posted     executed    cancelled    depth maxDepth maxLatencyMs\n");
+    for (int i = 0; i < LANE_COUNT; i++) {
+        LaneStats stats;
+        GetLaneStats(static_cast<ExecutorLane>(i), stats);
+        dprintf(fd, "%11s %12llu %12llu %12llu %8lld %8lld %12lld\n", GetLaneName(static_cast<ExecutorLane>(i)),
+            static_cast<unsigned long long>(stats.posted), static_cast<unsigned long long>(stats.executed),
+            static_cast<unsigned long long>(stats.cancelled), static_cast<long long>(stats.depth),
+            static_cast<long long>(stats.maxDepth), static_cast<long long>(stats.maxLatencyMs));
+    }
+}
+} // namespace Memory
+} // namespace OHOS
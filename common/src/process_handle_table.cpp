@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "process_handle_table.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <vector>
+
+#include "epoll_reactor.h"
+#include "kernel_interface.h"
+#include "memmgr_log.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "ProcessHandleTable";
+}
+
+IMPLEMENT_SINGLE_INSTANCE(ProcessHandleTable);
+
+bool ProcessHandleTable::SampleProcInfo(pid_t pid, ProcessHandle &handle)
+{
+    ProcInfo procInfo;
+    procInfo.pid = pid;
+    if (!KernelInterface::GetInstance().GetPidProcInfo(procInfo)) {
+        return false;
+    }
+    handle.state = procInfo.status.empty() ? '\0' : procInfo.status[0];
+    handle.rssKB = procInfo.size;
+    return true;
+}
+
+void ProcessHandleTable::CloseHandleLocked(std::unordered_map<pid_t, ProcessHandle>::iterator it)
+{
+    if (it->second.watched) {
+        EpollReactor::GetInstance().RemoveFd(it->second.pidfd);
+    }
+    if (it->second.pidfd >= 0) {
+        close(it->second.pidfd);
+    }
+    unwatchedPids_.erase(it->first);
+    handles_.erase(it);
+}
+
+void ProcessHandleTable::WatchExitLocked(pid_t pid, ProcessHandle &handle)
+{
+    if (exitCallback_ == nullptr) {
+        unwatchedPids_.insert(pid); // nobody cares the exit, keep the handle until unregistered or refreshed
+        return;
+    }
+    int pidfd = handle.pidfd;
+    // pidfd becomes readable when the process exits, it is readable at once if the process has exited
+    handle.watched = EpollReactor::GetInstance().AddFd(pidfd, EPOLLIN, ReactorPriority::HIGH, "pidfd",
+        [this, pid](int fd, uint32_t events) { this->HandleExit(pid, fd); });
+    if (handle.watched) {
+        unwatchedPids_.erase(pid);
+    } else {
+        unwatchedPids_.insert(pid);
+    }
+}
+
+void ProcessHandleTable::HandleExit(pid_t pid, int pidfd)
+{
+    ExitCallback callback;
+    int uid = -1;
+    {
+        std::lock_guard<std::mutex> lock(handlesLock_);
+        auto it = handles_.find(pid);
+        if (it == handles_.end() || it->second.pidfd != pidfd) {
+            return; // unregistered after the event is polled
+        }
+        uid = it->second.uid;
+        CloseHandleLocked(it);
+        callback = exitCallback_;
+    }
+    exitedCount_.fetch_add(1, std::memory_order_relaxed);
+    HILOGD("pid=%{public}d exited", pid);
+    if (callback != nullptr) {
+        callback(pid, uid);
+    }
+}
+
+void ProcessHandleTable::SetExitCallback(ExitCallback callback)
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    exitCallback_ = callback;
+}
+
+bool ProcessHandleTable::IsExitWatchComplete()
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    return exitCallback_ != nullptr && unwatchedPids_.empty();
+}
+
+bool ProcessHandleTable::Register(pid_t pid, int uid)
+{
+    if (pid <= 0) {
+        return false;
+    }
+    ProcessHandle handle;
+    handle.uid = uid;
+    handle.pidfd = KernelInterface::GetInstance().PidfdOpen(pid);
+    if (handle.pidfd < 0) {
+        int err = errno;
+        HILOGE("open pidfd of pid=%{public}d failed, errno=%{public}d", pid, err);
+        if (err != ESRCH) {
+            // alive but not watched, it is found by scan until unregistered
+            std::lock_guard<std::mutex> lock(handlesLock_);
+            unwatchedPids_.insert(pid);
+        }
+        return false;
+    }
+    SampleProcInfo(pid, handle);
+
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    auto it = handles_.find(pid);
+    if (it != handles_.end()) {
+        // the old process died without being unregistered, and its pid is reused
+        HILOGI("pid=%{public}d is registered again, drop the old handle", pid);
+        CloseHandleLocked(it);
+    }
+    WatchExitLocked(pid, handle);
+    handles_.emplace(pid, handle);
+    HILOGD("pid=%{public}d registered, pidfd=%{public}d", pid, handle.pidfd);
+    return true;
+}
+
+void ProcessHandleTable::Unregister(pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    auto it = handles_.find(pid);
+    if (it != handles_.end()) {
+        CloseHandleLocked(it);
+    }
+    unwatchedPids_.erase(pid);
+}
+
+void ProcessHandleTable::Clear()
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    for (auto &pair : handles_) {
+        if (pair.second.watched) {
+            EpollReactor::GetInstance().RemoveFd(pair.second.pidfd);
+        }
+        if (pair.second.pidfd >= 0) {
+            close(pair.second.pidfd);
+        }
+    }
+    handles_.clear();
+    unwatchedPids_.clear();
+}
+
+bool ProcessHandleTable::IsRegistered(pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    return handles_.find(pid) != handles_.end();
+}
+
+bool ProcessHandleTable::GetHandle(pid_t pid, ProcessHandle &handle)
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    auto it = handles_.find(pid);
+    if (it == handles_.end()) {
+        return false;
+    }
+    handle = it->second;
+    return true;
+}
+
+bool ProcessHandleTable::Refresh(pid_t pid)
+{
+    if (!IsRegistered(pid)) {
+        return false;
+    }
+    ProcessHandle sample;
+    if (!SampleProcInfo(pid, sample)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    auto it = handles_.find(pid);
+    if (it == handles_.end()) {
+        return false;
+    }
+    it->second.state = sample.state;
+    it->second.rssKB = sample.rssKB;
+    return true;
+}
+
+void ProcessHandleTable::RefreshAll()
+{
+    std::vector<std::pair<pid_t, int>> targets;
+    std::vector<pid_t> unwatched;
+    {
+        std::lock_guard<std::mutex> lock(handlesLock_);
+        targets.reserve(handles_.size());
+        for (auto &pair : handles_) {
+            targets.emplace_back(pair.first, pair.second.pidfd);
+        }
+        for (pid_t pid : unwatchedPids_) {
+            if (handles_.find(pid) == handles_.end()) {
+                unwatched.push_back(pid); // pidfd not opened, check by procfs
+            }
+        }
+    }
+    for (pid_t pid : unwatched) {
+        ProcessHandle sample;
+        if (!SampleProcInfo(pid, sample)) {
+            std::lock_guard<std::mutex> lock(handlesLock_);
+            if (handles_.find(pid) == handles_.end()) {
+                unwatchedPids_.erase(pid);
+            }
+        }
+    }
+    int diedCount = 0;
+    for (auto &target : targets) {
+        // pidfd becomes readable when the process exits
+        struct pollfd pfd = { target.second, POLLIN, 0 };
+        bool died = (poll(&pfd, 1, 0) > 0);
+        ProcessHandle sample;
+        if (!died && !SampleProcInfo(target.first, sample)) {
+            died = true;
+        }
+        std::lock_guard<std::mutex> lock(handlesLock_);
+        auto it = handles_.find(target.first);
+        if (it == handles_.end() || it->second.pidfd != target.second) {
+            continue; // changed during sampling
+        }
+        if (died) {
+            CloseHandleLocked(it);
+            diedCount++;
+            continue;
+        }
+        it->second.state = sample.state;
+        it->second.rssKB = sample.rssKB;
+    }
+    HILOGD("refreshed %{public}zu handles, %{public}d died", targets.size(), diedCount);
+}
+
+bool ProcessHandleTable::KillProcess(pid_t pid, int &freedKB)
+{
+    freedKB = 0;
+    int releaseFd = -1;
+    {
+        std::lock_guard<std::mutex> lock(handlesLock_);
+        auto it = handles_.find(pid);
+        if (it == handles_.end()) {
+            return false;
+        }
+        // decide by the state and rss cached on refresh, procfs is never read on the kill path
+        if (it->second.state == 'D') {
+            HILOGE("pid=%{public}d is at D status!", pid);
+            return true;
+        }
+        // send under lock, so that the pidfd can not be closed and reused meanwhile
+        if (!KernelInterface::GetInstance().PidfdSendSignal(it->second.pidfd, SIGKILL)) {
+            int err = errno;
+            HILOGE("kill pid=%{public}d through pidfd failed, errno=%{public}d", pid, err);
+            if (err == ESRCH) {
+                CloseHandleLocked(it); // died already, never signal a new process with the same pid
+            }
+            return true;
+        }
+        freedKB = it->second.rssKB;
+        releaseFd = fcntl(it->second.pidfd, F_DUPFD_CLOEXEC, 0);
+    }
+    HILOGE("pid=%{public}d has been killed through pidfd, freedSize=%{public}d KB", pid, freedKB);
+    if (releaseFd >= 0) {
+        // reap the address space now instead of waiting for the victim to be scheduled
+        if (!KernelInterface::GetInstance().ProcessMrelease(releaseFd)) {
+            HILOGD("process_mrelease pid=%{public}d failed, errno=%{public}d", pid, errno);
+        }
+        close(releaseFd);
+    }
+    return true;
+}
+
+int ProcessHandleTable::WaitForExit(const std::vector<pid_t> &pids, int timeoutMs)
+{
+    std::vector<struct pollfd> pfds;
+    int exitedCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(handlesLock_);
+        for (pid_t pid : pids) {
+            auto it = handles_.find(pid);
+            int fd = (it == handles_.end()) ? -1 : fcntl(it->second.pidfd, F_DUPFD_CLOEXEC, 0);
+            if (fd < 0) {
+                exitedCount++; // not managed any more, no way to wait for it
+                continue;
+            }
+            pfds.push_back({ fd, POLLIN, 0 });
+        }
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    size_t waiting = pfds.size();
+    while (waiting > 0) {
+        int64_t remain = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remain <= 0) {
+            break;
+        }
+        int ret = poll(pfds.data(), pfds.size(), static_cast<int>(remain));
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        for (auto &pfd : pfds) {
+            if (pfd.fd >= 0 && pfd.revents != 0) {
+                close(pfd.fd);
+                pfd.fd = -1; // negative fd is ignored by poll
+                exitedCount++;
+                waiting--;
+            }
+        }
+    }
+    for (auto &pfd : pfds) {
+        if (pfd.fd >= 0) {
+            close(pfd.fd);
+        }
+    }
+    HILOGD("%{public}d/%{public}zu processes exited", exitedCount, pids.size());
+    return exitedCount;
+}
+
+size_t ProcessHandleTable::Size()
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    return handles_.size();
+}
+
+void ProcessHandleTable::Dump(int fd)
+{
+    std::lock_guard<std::mutex> lock(handlesLock_);
+    dprintf(fd, "process handles: %zu, %zu unwatched, %llu exits watched\n", handles_.size(), unwatchedPids_.size(),
+        static_cast<unsigned long long>(exitedCount_.load(std::memory_order_relaxed)));
+    dprintf(fd, "     pid  pidfd state    rssKB watched\n");
+    for (auto &pair : handles_) {
+        dprintf(fd, "%8d %6d %5c %8d %7d\n", pair.first, pair.second.pidfd,
+            pair.second.state == '\0' ? '-' : pair.second.state, pair.second.rssKB, pair.second.watched);
+    }
+}
+} // namespace Memory
+} // namespace OHOS
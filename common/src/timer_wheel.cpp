@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace OHOS {
+namespace Memory {
+TimerWheel::TimerWheel(int64_t tickMs, int64_t nowMs) : tickMs_(tickMs > 0 ? tickMs : 1), baseMs_(nowMs)
+{
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(int64_t nowMs, int64_t delayMs, Callback callback)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    int64_t expireMs = std::max(nowMs + std::max<int64_t>(delayMs, 0) - baseMs_, static_cast<int64_t>(0));
+    Timer timer;
+    timer.id = nextId_++;
+    // round up, a timer never expires early
+    timer.expireTick = std::max(static_cast<uint64_t>((expireMs + tickMs_ - 1) / tickMs_), currentTick_ + 1);
+    timer.callback = std::move(callback);
+    TimerId id = timer.id;
+    PlaceLocked(std::move(timer));
+    return id;
+}
+
+void TimerWheel::PlaceLocked(Timer &&timer)
+{
+    // the lowest level whose slot of the timer is in the next round of the current one
+    int level = 0;
+    uint64_t slotTick = timer.expireTick;
+    while (level < LEVELS - 1 &&
+        (timer.expireTick >> (SLOT_BITS * level)) - (currentTick_ >> (SLOT_BITS * level)) >= SLOTS) {
+        level++;
+    }
+    uint64_t shift = SLOT_BITS * level;
+    if ((slotTick >> shift) - (currentTick_ >> shift) >= SLOTS) {
+        // beyond the range of the wheel, park it at the farthest slot and place it again when cascaded
+        slotTick = ((currentTick_ >> shift) + SLOTS - 1) << shift;
+    }
+    uint64_t slot = (slotTick >> shift) & SLOT_MASK;
+    TimerId id = timer.id;
+    Slot &target = wheels_[level][slot];
+    target.push_back(std::move(timer));
+    index_[id] = { level, slot, std::prev(target.end()) };
+}
+
+bool TimerWheel::Cancel(TimerId id)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        return false;
+    }
+    wheels_[it->second.level][it->second.slot].erase(it->second.it);
+    index_.erase(it);
+    return true;
+}
+
+void TimerWheel::CascadeLocked(int level, uint64_t slot)
+{
+    Slot timers;
+    timers.swap(wheels_[level][slot]);
+    for (auto &timer : timers) {
+        index_.erase(timer.id);
+        PlaceLocked(std::move(timer));
+    }
+}
+
+void TimerWheel::ExpireLocked(uint64_t tick, std::vector<Callback> &expired)
+{
+    Slot timers;
+    timers.swap(wheels_[0][tick & SLOT_MASK]);
+    for (auto &timer : timers) {
+        index_.erase(timer.id);
+        if (timer.expireTick <= tick) {
+            expired.push_back(std::move(timer.callback));
+        } else {
+            PlaceLocked(std::move(timer));
+        }
+    }
+}
+
+size_t TimerWheel::Advance(int64_t nowMs, std::vector<Callback> &expired)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    if (nowMs < baseMs_) {
+        return 0;
+    }
+    uint64_t targetTick = static_cast<uint64_t>((nowMs - baseMs_) / tickMs_);
+    size_t count = expired.size();
+    while (currentTick_ < targetTick) {
+        // ticks without a slot to expire or cascade are skipped
+        uint64_t nextTick = NextTickLocked();
+        if (nextTick > targetTick) {
+            currentTick_ = targetTick;
+            break;
+        }
+        currentTick_ = nextTick;
+        // higher levels first, so that timers cascaded to a lower level at this tick are cascaded again
+        for (int level = LEVELS - 1; level > 0; level--) {
+            uint64_t shift = SLOT_BITS * level;
+            if ((currentTick_ & ((1ULL << shift) - 1)) == 0) {
+                CascadeLocked(level, (currentTick_ >> shift) & SLOT_MASK);
+            }
+        }
+        ExpireLocked(currentTick_, expired);
+    }
+    return expired.size() - count;
+}
+
+uint64_t TimerWheel::NextTickLocked()
+{
+    uint64_t nextTick = UINT64_MAX;
+    if (index_.empty()) {
+        return nextTick;
+    }
+    for (int level = 0; level < LEVELS; level++) {
+        uint64_t shift = SLOT_BITS * level;
+        uint64_t base = currentTick_ >> shift;
+        // the current slot of each level is always empty, a slot ahead is expired or cascaded at its first tick
+        for (uint64_t i = 1; i < SLOTS; i++) {
+            uint64_t tick = (base + i) << shift;
+            if (tick >= nextTick) {
+                break;
+            }
+            if (!wheels_[level][(base + i) & SLOT_MASK].empty()) {
+                nextTick = tick;
+                break;
+            }
+        }
+    }
+    return nextTick;
+}
+
+int64_t TimerWheel::NextWakeupMs()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    uint64_t nextTick = NextTickLocked();
+    if (nextTick == UINT64_MAX) {
+        return -1;
+    }
+    return baseMs_ + static_cast<int64_t>(nextTick) * tickMs_;
+}
+
+size_t TimerWheel::Size()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return index_.size();
+}
+
+void TimerWheel::Clear()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    for (auto &wheel : wheels_) {
+        for (auto &slot : wheel) {
+            slot.clear();
+        }
+    }
+    index_.clear();
+}
+} // namespace Memory
+} // namespace OHOS
@@ -15,8 +15,10 @@
 #ifndef OHOS_MEMORY_DUMP_COMMAND_DISPATCHER_H
 #define OHOS_MEMORY_DUMP_COMMAND_DISPATCHER_H
 
+#include "memcg_stats_sampler.h"
 #include "memory_level_constants.h"
 #include "memory_level_manager.h"
+#include "reclaim_ratio_controller.h"
 #ifdef USE_PURGEABLE_MEMORY
 #include "purgeable_mem_manager.h"
 #endif
@@ -254,6 +256,8 @@ void DispatchDumpCommand(const int fd, std::map<std::string, std::vector<std::st
     if (HasCommand(keyValuesMapping, "-a")) {
         MemMgrEventCenter::GetInstance().Dump(fd);
         ReclaimPriorityManager::GetInstance().Dump(fd);
+        MemcgStatsSampler::GetInstance().Dump(fd);
+        ReclaimRatioController::GetInstance().Dump(fd);
         return;
     }
     if (HasCommand(keyValuesMapping, "-e")) {
@@ -262,6 +266,8 @@ void DispatchDumpCommand(const int fd, std::map<std::string, std::vector<std::st
     }
     if (HasCommand(keyValuesMapping, "-r")) {
         ReclaimPriorityManager::GetInstance().Dump(fd);
+        MemcgStatsSampler::GetInstance().Dump(fd);
+        ReclaimRatioController::GetInstance().Dump(fd);
         return;
     }
     if (HasCommand(keyValuesMapping, "-c")) {
@@ -15,9 +15,7 @@
 #ifndef OHOS_MEMORY_MEMMGR_KSWAPD_OBSERVER_H
 #define OHOS_MEMORY_MEMMGR_KSWAPD_OBSERVER_H
 
-#include "event_handler.h"
-
-struct epoll_event;
+#include <cstdint>
 
 namespace OHOS {
 namespace Memory {
@@ -33,13 +31,10 @@ public:
     void Init();
 
 private:
-    // run MainLoop on handler thread
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
-    int epollfd_ = -1;
     int kswapdMonitorFd_ = -1;
     bool RegisterKswapdListener();
-    void MainLoop(void);
-    void HandleEventEpollHup(struct epoll_event *curEpollEvent);
+    void HandleKswapdEvent(int fd, uint32_t events);
+    void HandleEventEpollHup(int fd);
 };
 } // namespace Memory
 } // namespace OHOS
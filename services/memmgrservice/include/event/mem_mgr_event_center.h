@@ -18,9 +18,9 @@
 
 #include "account_observer.h"
 #include "common_event_observer.h"
-#include "event_handler.h"
 #include "extension_connection_observer.h"
 #include "kswapd_observer.h"
+#include "memmgr_executor.h"
 #include "memory_pressure_observer.h"
 #include "single_instance.h"
 #ifdef CONFIG_BGTASK_MGR
@@ -73,7 +73,7 @@ private:
     int regAccountObsRetry_ = 0;
     int regAppStatusObsRetry_ = 0;
     std::unique_ptr<AppExecFwk::AppMgrClient> appMgrClient_;
-    std::shared_ptr<AppExecFwk::EventHandler> regObsHandler_;
+    std::shared_ptr<LaneHandler> regObsHandler_;
     std::shared_ptr<ExtensionConnectionObserver> extConnObserver_;
     std::shared_ptr<AccountObserver> accountObserver_;
     std::shared_ptr<CommonEventObserver> commonEventObserver_;
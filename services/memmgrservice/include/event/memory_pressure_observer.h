@@ -16,9 +16,10 @@
 #ifndef OHOS_MEMORY_MEMMGR_MEMORY_PRESSURE_MONITOR_H
 #define OHOS_MEMORY_MEMMGR_MEMORY_PRESSURE_MONITOR_H
 
-#include "event_handler.h"
+#include <cstdint>
+#include <vector>
 
-struct epoll_event;
+#include "psi_config.h"
 
 #define MS_PER_SECOND 1000
 
@@ -26,42 +27,18 @@ struct epoll_event;
 
 #define US_PER_MS 1000
 
-#define WINDOW_IN_MS 1000
-
 #define MEMORY_PRESSURE_FILE "/proc/pressure/memory"
 
 #define POLL_PERIOD_MS 10
 
-#define POLL_COUNT (WINDOW_IN_MS / POLL_PERIOD_MS)
-
 namespace OHOS {
 namespace Memory {
-enum MemPressureLevel {
-    LEVEL_0 = 0,
-    MEM_PRESS_LEVEL_COUNT
-};
-
-enum StallType {
-    SOME,
-    FULL,
-    STALL_TYPE_COUNT
-};
-
-struct LevelHandler {
-    int data;
-    void (*handler)(int data, uint32_t events);
-};
-
 struct MemPressLevelCfg {
-    enum MemPressureLevel level;
+    int level;
     enum StallType stallType;
     int thresholdInMs;
+    int windowInMs;
     int levelFileFd;
-    struct LevelHandler levelHandler;
-};
-
-static struct MemPressLevelCfg levelConfigArr[MEM_PRESS_LEVEL_COUNT] = {
-    { LEVEL_0, SOME, 10, -1},    /* 10ms out of 1sec for partial stall */
 };
 
 
@@ -73,21 +50,17 @@ public:
     ~MemoryPressureObserver();
     void Init();
 private:
-    // run MainLoop on handler thread
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
-    int epollfd_ = -1;
     // current monitor level count
     int curLevelCount_ = 0;
-    struct LevelHandler *handlerInfo_ = nullptr;
+    // index is the level, from the mildest stall to the most urgent one.
+    // never resized after Init, since it is used by level events on the reactor thread.
+    std::vector<MemPressLevelCfg> levelConfigs_;
 
-    bool MonitorLevel(MemPressureLevel level);
+    bool MonitorLevel(int level);
     int CreateLevelFileFd(StallType stallType, int thresholdInUs, int windowInUs);
-    int AddLevelFileFdToEpoll(int epollfd, int fd, void* data);
-    void UnMonitorLevel(MemPressureLevel level);
-    int delLevelFileFdFromEpoll(int epollfd, int fd);
+    void UnMonitorLevel(int level);
     void CloseLevelFileFd(int fd);
-    void MainLoop(void);
-    void HandleEpollEvent(struct epoll_event *curEpollEvent);
+    void HandleLevelEvent(int level, uint32_t events);
 };
 } // namespace Memory
 } // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_PSI_EVENT_DISPATCHER_H
+#define OHOS_MEMORY_MEMMGR_PSI_EVENT_DISPATCHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "memmgr_executor.h"
+#include "single_instance.h"
+
+namespace OHOS {
+namespace Memory {
+struct PsiConsumerStats {
+    uint64_t events = 0; // psi events dispatched to the consumer
+    uint64_t runs = 0; // evaluations run by the consumer
+    uint64_t merged = 0; // events merged into a pending evaluation
+    uint64_t dropped = 0; // events dropped since posting to the handler failed
+    int lastLevel = 0; // psi level of the last evaluation
+};
+
+/*
+ * Dispatches psi events to consumers which evaluate memory state on their own handlers.
+ * At most one evaluation is pending for each consumer. Events arriving before the pending one
+ * starts are merged into it, and events arriving during an evaluation make one more pass after
+ * it, since it may have read data older than them. So a burst of events costs at most two passes.
+ * An evaluation is run with the most urgent psi level of the events merged into it.
+ */
+class PsiEventDispatcher {
+    DECLARE_SINGLE_INSTANCE(PsiEventDispatcher);
+
+public:
+    using ConsumerFunc = std::function<void(int level)>;
+    bool AddConsumer(const std::string &name, std::shared_ptr<LaneHandler> handler,
+        ConsumerFunc func);
+    // request one evaluation of the consumer, return false if it is not added
+    bool Dispatch(const std::string &name, int level = 0);
+    bool GetConsumerStats(const std::string &name, PsiConsumerStats &stats);
+    void Dump(int fd);
+
+private:
+    class Consumer : public std::enable_shared_from_this<Consumer> {
+    public:
+        Consumer(std::shared_ptr<LaneHandler> handler, ConsumerFunc func);
+        void Dispatch(int level);
+        PsiConsumerStats GetStats() const;
+
+    private:
+        bool Post();
+        void Run();
+
+        std::shared_ptr<LaneHandler> handler_;
+        ConsumerFunc func_;
+        std::atomic<bool> scheduled_ {false};
+        // increased by each event, an evaluation is dirty if it changes during the evaluation
+        std::atomic<uint64_t> generation_ {0};
+        // the most urgent level of events not evaluated yet
+        std::atomic<int> pendingLevel_ {0};
+        std::atomic<int> lastLevel_ {0};
+        std::atomic<uint64_t> runs_ {0};
+        std::atomic<uint64_t> merged_ {0};
+        std::atomic<uint64_t> dropped_ {0};
+    };
+
+    std::shared_ptr<Consumer> FindConsumer(const std::string &name);
+
+    std::map<std::string, std::shared_ptr<Consumer>> consumers_;
+    std::mutex consumersLock_;
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_PSI_EVENT_DISPATCHER_H
@@ -21,10 +21,10 @@
 #include <mutex>
 #include <set>
 
-#include "event_handler.h"
 #include "iremote_object.h"
 #include "i_mem_mgr.h"
 #include "mem_mgr_window_info.h"
+#include "memmgr_executor.h"
 #include "reclaim_priority_manager.h"
 #include "single_instance.h"
 
@@ -47,7 +47,7 @@ public:
 private:
     WindowVisibilityObserver();
     ~WindowVisibilityObserver();
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
     std::function<void()> timerFunc_;
     std::map<int32_t, ProcessWindowVisibilityInfo> windowVisibleMap_;
     std::mutex mutex_ {};
@@ -16,7 +16,11 @@
 #ifndef OHOS_MEMORY_MEMMGR_LOW_MEMORY_KILLER_H
 #define OHOS_MEMORY_MEMMGR_LOW_MEMORY_KILLER_H
 
-#include "event_handler.h"
+#include <sys/types.h>
+#include <unordered_set>
+#include <vector>
+
+#include "memmgr_executor.h"
 #include "single_instance.h"
 
 namespace OHOS {
@@ -25,17 +29,22 @@ class  LowMemoryKiller {
     DECLARE_SINGLE_INSTANCE_BASE(LowMemoryKiller);
 
 public:
-    void PsiHandler();
+    // level is the index of the reporting psi level, a larger one is more urgent
+    void PsiHandler(int level = 0);
     int32_t GetKillLevel();
+    // kill through pidfd if the process is registered, or by pid with a warning. return KB freed
+    int KillOneProcess(pid_t pid);
 private:
     LowMemoryKiller();
     ~LowMemoryKiller() = default;
     std::pair<unsigned int, int> QueryKillMemoryPriorityPair(unsigned int currBufferKB,
             unsigned int &targetBufKB, int &killLevel);
-    void PsiHandlerInner();
+    void PsiHandlerInner(int level = 0);
     int KillOneBundleByPrio(int minPrio);
+    // killedUids are bundles killed earlier in the same event, skipped even if the snapshot is not updated yet
+    int KillOneBundleByPrio(int minPrio, std::vector<pid_t> &killedPids, std::unordered_set<int> &killedUids);
     bool GetEventHandler();
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
 
     bool initialized_ = false;
     long calledCount_ = 0;
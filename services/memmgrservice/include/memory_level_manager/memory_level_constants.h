@@ -48,6 +48,7 @@ enum class MemorySource {
 struct SystemMemoryInfo {
     MemorySource source;
     SystemMemoryLevel level;
+    int psiLevel = 0; // index of the reporting psi level, a larger one is more urgent
 };
 
 typedef struct SystemMemoryInfo SystemMemoryInfo;
@@ -16,7 +16,7 @@
 #ifndef OHOS_MEMORY_MEMMGR_MEMORY_LEVEL_MANAGER_H
 #define OHOS_MEMORY_MEMMGR_MEMORY_LEVEL_MANAGER_H
 
-#include "event_handler.h"
+#include "memmgr_executor.h"
 #include "memory_level_constants.h"
 #include "single_instance.h"
 
@@ -33,19 +33,19 @@ class MemoryLevelManager {
     DECLARE_SINGLE_INSTANCE_BASE(MemoryLevelManager);
 
 public:
-    void PsiHandler();
+    void PsiHandler(int level = 0);
     void TriggerMemoryLevelByDump(SystemMemoryInfo &info);
 
 private:
     MemoryLevelManager();
     ~MemoryLevelManager() = default;
-    void PsiHandlerInner();
+    void PsiHandlerInner(int level = 0);
     void NotifyMemoryLevel(SystemMemoryInfo &info);
     bool GetEventHandler();
     bool CalcSystemMemoryLevel(SystemMemoryInfo &info);
     bool CalcReclaimAppList(std::vector<std::shared_ptr<AppEntity>> &appList);
     void NotifyMemoryLevelToSystemAbilityManager();
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
     bool initialized_ = false;
     long calledCount_ = 0;
 };
@@ -17,7 +17,7 @@
 #define OHOS_MEMORY_MEMMGR_NANDLIFE_CONTROLLER_H
 
 #include "single_instance.h"
-#include "event_handler.h"
+#include "memmgr_executor.h"
 #include "memmgr_config_manager.h"
 
 namespace OHOS {
@@ -28,7 +28,7 @@ class NandLifeController {
 public:
     bool Init();
 private:
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
     NandLifeConfig config_;
 
     unsigned long long DAILY_SWAP_OUT_QUOTA_KB;
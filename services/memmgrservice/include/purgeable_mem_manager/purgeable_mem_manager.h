@@ -20,8 +20,8 @@
 #include <unordered_map>
 
 #include "app_state_subscriber.h"
-#include "event_handler.h"
 #include "kernel_interface.h"
+#include "memmgr_executor.h"
 #include "memory_level_constants.h"
 #include "purgeable_mem_constants.h"
 #include "purgeable_mem_utils.h"
@@ -91,7 +91,7 @@ private:
     void ReclaimSubscriberAll();
     bool GetEventHandler();
     bool CheckCallingToken();
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
     bool initialized_ = false;
     std::map<int32_t, std::pair<int32_t, int32_t>> appList_;
     std::list<sptr<IAppStateSubscriber>> appStateSubscribers_ {};
@@ -99,6 +99,7 @@ private:
     std::mutex mutexAppList_;
     std::mutex mutexSubscribers_;
     time_t lastTriggerTime_ = 0; // last trigger time by psi or kswapd.
+    int lastTriggerPsiLevel_ = 0; // psi level of the last trigger, 0 if triggered by kswapd.
 };
 } // namespace Memory
 } // namespace OHOS
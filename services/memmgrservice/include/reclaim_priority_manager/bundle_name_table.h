@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_BUNDLE_NAME_TABLE_H
+#define OHOS_MEMORY_MEMMGR_BUNDLE_NAME_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace Memory {
+/*
+ * Names of bundles and processes interned once for the whole service, each of them is
+ * identified by a 32-bit id. Names are never removed, since the count of them is bounded by
+ * the apps installed. Getting a name by id takes no lock.
+ */
+class BundleNameTable {
+    DECLARE_SINGLE_INSTANCE_BASE(BundleNameTable);
+
+public:
+    using Id = uint32_t;
+    static constexpr Id EMPTY_ID = 0; // id of the empty name
+
+    Id Intern(const std::string &name);
+    // return false if the name is never interned, the name is not interned by it
+    bool Find(const std::string &name, Id &id);
+    // the reference is valid for the whole life of the service
+    const std::string &GetName(Id id) const;
+    size_t Size() const;
+
+private:
+    static constexpr uint32_t CHUNK_BITS = 10;
+    static constexpr uint32_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static constexpr uint32_t MAX_CHUNKS = 1024;
+
+    BundleNameTable();
+    ~BundleNameTable();
+
+    std::mutex lock_;
+    std::unordered_map<std::string, Id> ids_;
+    // names are stored in chunks never moved, chunks are published before ids in them are handed out
+    std::atomic<std::string *> chunks_[MAX_CHUNKS];
+    std::atomic<uint32_t> count_ {0};
+};
+
+// interned name held by bundles and snapshots, copies and compares of it are integer ones
+class BundleName {
+public:
+    BundleName() = default;
+    explicit BundleName(const std::string &name) : id_(BundleNameTable::GetInstance().Intern(name)) {}
+
+    BundleNameTable::Id GetId() const
+    {
+        return id_;
+    }
+
+    const std::string &Str() const
+    {
+        return BundleNameTable::GetInstance().GetName(id_);
+    }
+
+    const char *c_str() const
+    {
+        return Str().c_str();
+    }
+
+    bool empty() const
+    {
+        return id_ == BundleNameTable::EMPTY_ID;
+    }
+
+    operator const std::string &() const
+    {
+        return Str();
+    }
+
+    bool operator==(const BundleName &other) const
+    {
+        return id_ == other.id_;
+    }
+
+    bool operator!=(const BundleName &other) const
+    {
+        return id_ != other.id_;
+    }
+
+private:
+    BundleNameTable::Id id_ = BundleNameTable::EMPTY_ID;
+};
+
+inline bool operator==(const BundleName &name, const std::string &str)
+{
+    return name.Str() == str;
+}
+
+inline bool operator==(const std::string &str, const BundleName &name)
+{
+    return name.Str() == str;
+}
+
+inline bool operator!=(const BundleName &name, const std::string &str)
+{
+    return !(name == str);
+}
+
+inline bool operator!=(const std::string &str, const BundleName &name)
+{
+    return !(name == str);
+}
+
+inline std::ostream &operator<<(std::ostream &os, const BundleName &name)
+{
+    return os << name.Str();
+}
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_BUNDLE_NAME_TABLE_H
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_BUNDLE_PRIORITY_INDEX_H
+#define OHOS_MEMORY_MEMMGR_BUNDLE_PRIORITY_INDEX_H
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "bundle_priority_info.h"
+#include "reclaim_priority_constants.h"
+
+namespace OHOS {
+namespace Memory {
+/*
+ * Index of bundles bucketed by priority, one bucket for each priority in
+ * [RECLAIM_PRIORITY_MIN, RECLAIM_PRIORITY_MAX]. Bundles of a bucket are linked in a list,
+ * the latest one moved into the bucket is at the head.
+ * Iterating is in ascending order of priority, so the reverse iterating visits bundles from
+ * the highest priority, and the least recently moved one first in the same priority.
+ * Insert, erase and priority update are O(1), and a bitmap of non-empty buckets is used to
+ * skip empty buckets when iterating.
+ */
+class BundlePriorityIndex {
+private:
+    struct Node {
+        std::shared_ptr<BundlePriorityInfo> bundle;
+        Node *prev = nullptr;
+        Node *next = nullptr;
+        int bucket = -1;
+    };
+
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::shared_ptr<BundlePriorityInfo>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::shared_ptr<BundlePriorityInfo>*;
+        using reference = const std::shared_ptr<BundlePriorityInfo>&;
+
+        Iterator() = default;
+        reference operator*() const
+        {
+            return node_->bundle;
+        }
+        pointer operator->() const
+        {
+            return &node_->bundle;
+        }
+        Iterator& operator++();
+        Iterator operator++(int);
+        Iterator& operator--();
+        Iterator operator--(int);
+        bool operator==(const Iterator &other) const
+        {
+            return node_ == other.node_;
+        }
+        bool operator!=(const Iterator &other) const
+        {
+            return node_ != other.node_;
+        }
+
+    private:
+        friend class BundlePriorityIndex;
+        Iterator(const BundlePriorityIndex *index, Node *node) : index_(index), node_(node) {}
+
+        const BundlePriorityIndex *index_ = nullptr;
+        Node *node_ = nullptr; // nullptr means end
+    };
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+    using reverse_iterator = std::reverse_iterator<Iterator>;
+
+    BundlePriorityIndex() = default;
+    BundlePriorityIndex(const BundlePriorityIndex&) = delete;
+    BundlePriorityIndex& operator=(const BundlePriorityIndex&) = delete;
+
+    // bundles are unique by uid, return false in second if the uid is already in index
+    std::pair<Iterator, bool> insert(const std::shared_ptr<BundlePriorityInfo> &bundle);
+    size_t erase(const std::shared_ptr<BundlePriorityInfo> &bundle);
+    Iterator erase(Iterator pos);
+    // move the bundle to the bucket of its current priority, return false if it is not in index
+    bool Update(const std::shared_ptr<BundlePriorityInfo> &bundle);
+    bool Contains(int uid) const;
+    void clear();
+    size_t size() const;
+    bool empty() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+    reverse_iterator rbegin() const;
+    reverse_iterator rend() const;
+
+private:
+    static constexpr int BUCKET_COUNT = RECLAIM_PRIORITY_MAX - RECLAIM_PRIORITY_MIN + 1;
+    static constexpr int BITS_PER_WORD = 64;
+    static constexpr int BITMAP_WORDS = (BUCKET_COUNT + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    static int PriorityToBucket(int priority);
+    void Link(Node *node, int bucket);
+    void Unlink(Node *node);
+    // first node in buckets [bucket, BUCKET_COUNT), nullptr if none
+    Node* FirstNodeFrom(int bucket) const;
+    // last node in buckets [0, bucket], nullptr if none
+    Node* LastNodeUpTo(int bucket) const;
+
+    struct Bucket {
+        Node *head = nullptr;
+        Node *tail = nullptr;
+    };
+    Bucket buckets_[BUCKET_COUNT];
+    uint64_t nonEmptyBitmap_[BITMAP_WORDS] = {0};
+    // owns the nodes, node address is stable until it is erased
+    std::unordered_map<int, Node> nodes_;
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_BUNDLE_PRIORITY_INDEX_H
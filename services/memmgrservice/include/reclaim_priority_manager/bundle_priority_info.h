@@ -20,6 +20,7 @@
 #include <map>
 #include <mutex>
 
+#include "bundle_name_table.h"
 #include "reclaim_priority_constants.h"
 #include "process_priority_info.h"
 
@@ -31,12 +32,13 @@ public:
     explicit BundlePriorityInfo(const std::string &name, int bundleUid);
     explicit BundlePriorityInfo(const std::string &name, int bundleUid, int priority);
     explicit BundlePriorityInfo(const std::string &name, int bundleUid, int priority, int accountId, BundleState state);
+    explicit BundlePriorityInfo(const BundleName &name, int bundleUid, int priority, int accountId, BundleState state);
     BundlePriorityInfo(const BundlePriorityInfo &copyBundle);
     inline bool operator<(const BundlePriorityInfo &tmp) const
     {
         return priority_ < tmp.priority_;
     }
-    std::string name_;
+    BundleName name_;
     int uid_;
     ProcessesInfoMap procs_;
     int priority_;
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_BUNDLE_PRIORITY_SNAPSHOT_H
+#define OHOS_MEMORY_MEMMGR_BUNDLE_PRIORITY_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+#include "bundle_priority_index.h"
+#include "bundle_priority_info.h"
+#include "reclaim_priority_constants.h"
+
+namespace OHOS {
+namespace Memory {
+// fields of a bundle which are read by killer and reclaimer, never changed once published
+struct BundleSnapshotEntry {
+    int uid;
+    int accountId;
+    int priority;
+    BundleState state;
+    int64_t createTime;
+    BundleName name;
+    std::vector<pid_t> pids;
+};
+
+/*
+ * Immutable view of all managed bundles, in descending order of priority.
+ * A snapshot is published as a whole after each batch of priority updates, readers hold it
+ * through a shared_ptr, so they neither copy bundles nor block the updates.
+ */
+class BundlePrioritySnapshot {
+public:
+    using EntryPtr = std::shared_ptr<const BundleSnapshotEntry>;
+    using EntryList = std::vector<EntryPtr>;
+
+    BundlePrioritySnapshot(uint64_t version, EntryList &&bundles);
+    uint64_t GetVersion() const;
+    const EntryList& GetBundles() const;
+    size_t Size() const;
+
+private:
+    uint64_t version_;
+    EntryList bundles_;
+};
+using BundlePrioritySnapshotPtr = std::shared_ptr<const BundlePrioritySnapshot>;
+
+/*
+ * Builds snapshots from the priority index on the writer side. Entries of bundles which are
+ * not changed since last build are shared with the last snapshot, so only changed bundles are copied.
+ */
+class BundlePrioritySnapshotBuilder {
+public:
+    BundlePrioritySnapshotPtr Build(const BundlePriorityIndex &index);
+    void Reset();
+
+private:
+    static bool IsEntryOutdated(const BundleSnapshotEntry &entry, BundlePriorityInfo &bundle);
+    static BundlePrioritySnapshot::EntryPtr MakeEntry(BundlePriorityInfo &bundle);
+
+    uint64_t version_ = 0;
+    // map <bundleUid, entry in last snapshot>
+    std::unordered_map<int, BundlePrioritySnapshot::EntryPtr> lastEntries_;
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_BUNDLE_PRIORITY_SNAPSHOT_H
@@ -23,7 +23,7 @@
 #include "account_priority_info.h"
 #include "multi_account_strategy.h"
 #include "account_bundle_info.h"
-#include "event_handler.h"
+#include "memmgr_executor.h"
 #include "os_account_manager.h"
 
 namespace OHOS {
@@ -50,7 +50,7 @@ public:
 
 private:
     int retryTimes_ = 0;
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
     bool initialized_ = false;
     std::map<int, std::shared_ptr<AccountPriorityInfo>> accountMap_;
     std::shared_ptr<MultiAccountStrategy> strategy_;
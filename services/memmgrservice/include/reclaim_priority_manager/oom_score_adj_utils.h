@@ -16,14 +16,49 @@
 #ifndef OHOS_MEMORY_MEMMGR_OOM_SCORE_ADJ_UTILS_H
 #define OHOS_MEMORY_MEMMGR_OOM_SCORE_ADJ_UTILS_H
 
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "bundle_priority_info.h"
+#include "kernel_interface.h"
 
 namespace OHOS {
 namespace Memory {
+/*
+ * Writes of oom_score_adj skip the value last written to the same process, and needed ones
+ * go through cached fds of /proc/<pid>/oom_score_adj, in one KernelInterface::BatchWrite.
+ * Cache of a process should be forgotten when it dies, since its pid may be reused.
+ */
 class OomScoreAdjUtils {
 public:
+    using OomScoreAdjWrite = std::pair<pid_t, int>;
+
     static bool WriteOomScoreAdjToKernel(std::shared_ptr<BundlePriorityInfo> bundle);
     static bool WriteOomScoreAdjToKernel(pid_t pid, int priority);
+    // write values of one event, return the count of values written to kernel
+    static int WriteOomScoreAdjBatch(const std::vector<OomScoreAdjWrite> &writes);
+    static void ForgetProcess(pid_t pid);
+    static void ClearCache();
+    // get value last written to the process, return false if not cached
+    static bool GetCachedOomScoreAdj(pid_t pid, int &value);
+
+private:
+    struct CacheEntry {
+        int fd = -1;
+        int value = 0;
+        bool written = false; // false if only the fd is opened
+    };
+
+    // return false if the write is skipped
+    static bool PrepareWriteLocked(pid_t pid, int value, BatchWriteEntry &entry);
+    static void CommitWriteLocked(pid_t pid, int value, const BatchWriteEntry &entry);
+    static void CloseEntryLocked(CacheEntry &entry);
+
+    static std::mutex cacheLock_;
+    static std::unordered_map<pid_t, CacheEntry> cache_;
+    static size_t cachedFdCount_;
 };
 } // namespace Memory
 } // namespace OHOS
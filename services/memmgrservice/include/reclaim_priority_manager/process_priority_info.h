@@ -16,9 +16,13 @@
 #ifndef OHOS_MEMORY_MEMMGR_PROCESS_PRIORITY_INFO_H
 #define OHOS_MEMORY_MEMMGR_PROCESS_PRIORITY_INFO_H
 
+#include <cstdint>
+#include <memory>
 #include <set>
 #include <string>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "reclaim_strategy_constants.h"
 
@@ -30,30 +34,62 @@ constexpr int EXTENSION_STATUS_BG_BIND = 2;
 constexpr int EXTENSION_STATUS_NO_BIND = 3;
 const std::string DEFAULT_PROCESS_NAME = "";
 
+/*
+ * Map from pid to uid of processes bound with a process, ordered by pid like std::map.
+ * Nearly every process has no binding, so the storage is only allocated for the first one,
+ * and a flat vector is used since a process is bound with a few processes at most.
+ */
+class ProcBindMap {
+public:
+    using value_type = std::pair<int32_t, int32_t>;
+
+    ProcBindMap() = default;
+    ProcBindMap(const ProcBindMap &other);
+    ProcBindMap &operator=(const ProcBindMap &other);
+    ProcBindMap(ProcBindMap &&other) noexcept = default;
+    ProcBindMap &operator=(ProcBindMap &&other) noexcept = default;
+
+    const value_type *begin() const;
+    const value_type *end() const;
+    size_t size() const;
+    bool empty() const;
+    // uid of the pid, inserted if not found
+    int32_t &operator[](int32_t pid);
+    size_t erase(int32_t pid);
+    void clear();
+
+private:
+    std::unique_ptr<std::vector<value_type>> items_;
+};
+
 class ProcessPriorityInfo {
 public:
     explicit ProcessPriorityInfo(pid_t pid, int bundleUid, int priority, bool isImportant = false);
-    ProcessPriorityInfo(const ProcessPriorityInfo &copyProcess);
-    ~ProcessPriorityInfo();
+    ProcessPriorityInfo(const ProcessPriorityInfo &copyProcess) = default;
+    ProcessPriorityInfo &operator=(const ProcessPriorityInfo &copyProcess) = default;
+    ~ProcessPriorityInfo() = default;
 
     int uid_;
     pid_t pid_;
     int priority_;
     int priorityIfImportant_; // only enable when configured in xml, and should not be changed after read from xml
-    bool isImportant_; // true means important background, false means normal background
-    bool isVisible_;
-    bool isRender_;
-    bool isFreground; // true means freground, false means background
-    bool isBackgroundRunning;
-    bool isSuspendDelay;
-    bool isEventStart;
-    bool isDistDeviceConnected;
-    bool isExtension_;
-    bool hasUI_ = false;
     int extensionBindStatus; // 0: unkown, 1:fg bind, 2:bg bind, 3:no bind
-    std::map<int32_t, int32_t> procsBindToMe_;
-    std::map<int32_t, int32_t> procsBindFromMe_;
+    // state flags are packed in one word, so that copies of processes in bundles and snapshots are cheap
+    bool isImportant_ : 1; // true means important background, false means normal background
+    bool isVisible_ : 1;
+    bool isRender_ : 1;
+    bool isFreground : 1; // true means freground, false means background
+    bool isBackgroundRunning : 1;
+    bool isSuspendDelay : 1;
+    bool isEventStart : 1;
+    bool isDistDeviceConnected : 1;
+    bool isExtension_ : 1;
+    bool hasUI_ : 1;
+    ProcBindMap procsBindToMe_;
+    ProcBindMap procsBindFromMe_;
 
+    // priority given by the state flags only, important processes are not considered
+    int GetPriorityByStatus() const;
     void SetPriority(int targetPriority);
     int32_t ExtensionConnectorsCount();
 
@@ -73,7 +109,7 @@ public:
     int64_t GetStartingAbilityTime() const;
 
 private:
-    bool isAbilityStarting_; // true means proc current is starting ability, false means not
+    bool isAbilityStarting_ : 1; // true means proc current is starting ability, false means not
     int64_t startingAbilityTime_;
 };
 } // namespace Memory
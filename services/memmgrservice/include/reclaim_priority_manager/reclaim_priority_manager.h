@@ -17,20 +17,27 @@
 #define OHOS_MEMORY_MEMMGR_RECALIM_PRIORITY_MANAGER_H
 
 #include "single_instance.h"
-#include "event_handler.h"
+#include "memmgr_executor.h"
 #include "reclaim_priority_constants.h"
 #include "process_priority_info.h"
 #include "bundle_priority_info.h"
+#include "bundle_priority_index.h"
+#include "bundle_priority_snapshot.h"
 #include "account_bundle_info.h"
 #include "os_account_manager.h"
 #include "reclaim_param.h"
 #include "memmgr_config_manager.h"
+#include "timer_wheel.h"
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace OHOS {
 namespace Memory {
@@ -78,25 +85,6 @@ class ReclaimPriorityManager {
     DECLARE_SINGLE_INSTANCE_BASE(ReclaimPriorityManager);
 
 public:
-    struct BundleInfoPtrCmp {
-        bool operator() (const std::shared_ptr<BundlePriorityInfo> p1, const std::shared_ptr<BundlePriorityInfo> p2)
-        {
-            if (p1->uid_ == p2->uid_) {
-                // remove duplicate BundlePriorityInfo according to uid_
-                return false;
-            } else {
-                if (p1->priority_ != p2->priority_) {
-                    // in ascending order
-                    return p1->priority_ < p2->priority_;
-                } else {
-                    // when in same priority_, sort by uid_
-                    // it will be sorted by last used time
-                    return p1->uid_ < p2->uid_;
-                }
-            }
-        }
-    };
-
     struct BundleInfoCmp {
         bool operator() (const BundlePriorityInfo &p1, const BundlePriorityInfo &p2)
         {
@@ -116,28 +104,11 @@ public:
         }
     };
 
-    struct ProcInfoCmpByPriority {
-        bool operator() (const ProcessPriorityInfo &p1, const ProcessPriorityInfo &p2)
-        {
-            if (p1.pid_ == p2.pid_) {
-                return false;
-            } else {
-                if (p1.priority_ != p2.priority_) {
-                    return p1.priority_ < p2.priority_;
-                }
-
-                return p1.pid_ < p2.pid_;
-            }
-        }
-    };
-
-    using BundlePrioSet = std::set<std::shared_ptr<BundlePriorityInfo>, BundleInfoPtrCmp>;
+    using BundlePrioSet = BundlePriorityIndex;
     using BunldeCopySet = std::set<BundlePriorityInfo, BundleInfoCmp>;
     // map <bundleUid, std::shared_ptr<BundlePriorityInfo>>
     using BundlePrioMap = std::map<int, std::shared_ptr<BundlePriorityInfo>>;
     using OsAccountsMap = std::map<int, std::shared_ptr<AccountBundleInfo>>;
-    using ProcInfoVec = std::vector<ProcessPriorityInfo>;
-    using ProcInfoSet = std::set<ProcessPriorityInfo, ProcInfoCmpByPriority>;
     bool Init();
     bool UpdateReclaimPriority(UpdateRequest request);
     bool UpdateRecalimPrioritySyncWithLock(const UpdateRequest &request);
@@ -153,8 +124,22 @@ public:
 
     void GetOneKillableBundle(int minPrio, BunldeCopySet &bundleSet);
 
+    // for lmkd and memory reclaim, bundles as of the last batch of updates.
+    // it never waits for writers and copies nothing, prefer it to the two methods above.
+    // if bundles changed since the last build, the caller rebuilds it unless a writer holds the set.
+    BundlePrioritySnapshotPtr GetBundlePrioSnapshot();
+
     void SetBundleState(int accountId, int uid, BundleState state);
 
+    // package of the uid is installed, updated or removed, answers of BundleMgr for it are outdated.
+    // a negative uid drops answers of all uids.
+    void NotifyPackageChanged(int uid);
+
+    // foreground changes reported by app state callbacks, they keep the local foreground set up to date
+    void NotifyForegroundAppChanged(int32_t uid, const std::string &bundleName, bool isForeground);
+    // rebuild the foreground set from AppMgr, at startup and after AppMgr reconnects
+    void UpdateForegroundApps();
+
     // for hidumper, usage: hdc shell hidumper -s 1909
     void Dump(int fd);
 
@@ -167,33 +152,87 @@ private:
     // total system prioritySet
     // when new a BundlePriorityInfo, it will be added into this set
     // when delete a BundlePriorityInfo, it will be removed from this set
-    // when change the priority of BundlePriorityInfo, it will be removed and added from this set to re-sort it
+    // when change the priority of BundlePriorityInfo, it will be moved to the bucket of new priority
     BundlePrioSet totalBundlePrioSet_;
     std::mutex totalBundlePrioSetLock_;
+    // built from totalBundlePrioSet_ with totalBundlePrioSetLock_ held, loaded by readers without lock.
+    // writers only mark it dirty, it is rebuilt once by the next reader finding the set unlocked
+    BundlePrioritySnapshotBuilder bundlePrioSnapshotBuilder_;
+    BundlePrioritySnapshotPtr bundlePrioSnapshot_;
+    std::atomic<bool> bundlePrioSnapshotDirty_ {false};
 
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
     std::map<int32_t, std::string> updateReasonStrMapping_;
     std::string UNKOWN_REASON = "UNKOWN_REASON";
     ReclaimPriorityConfig config_;
     std::set<std::string> allKillableSystemApps_;
+    // interned from allKillableSystemApps_ and important processes of config_, so lookups compare ids only
+    std::unordered_set<BundleNameTable::Id> killableSystemAppIds_;
+    std::unordered_map<BundleNameTable::Id, int> importantProcIds_;
+    // keepAlive answered by BundleMgr for each uid, kept until package of the uid is changed
+    std::mutex keepAliveCacheLock_;
+    std::unordered_map<int, bool> keepAliveCache_;
+    uint64_t keepAliveCacheHits_ = 0;
+    uint64_t keepAliveQueries_ = 0;
+    // foreground apps keyed by uid and bundle name id, so IsFrontApp needs no IPC
+    std::mutex foregroundAppsLock_;
+    std::unordered_set<uint64_t> foregroundApps_;
+    bool foregroundAppsSynced_ = false;
+    // bumped by each callback, callbacks arriving while the list is fetched from AppMgr are
+    // kept and applied on top of the list, which may be older than them
+    struct ForegroundAppChange {
+        uint64_t version;
+        uint64_t key;
+        bool isForeground;
+    };
+    uint64_t foregroundAppsVersion_ = 0;
+    int foregroundAppsSyncing_ = 0;
+    std::vector<ForegroundAppChange> foregroundAppChanges_;
     using ChangeProcFunc = void (ReclaimPriorityManager::*)(ProcessPriorityInfo &proc, AppAction &action,
         int64_t eventTime);
     std::map<AppStateUpdateReason, ChangeProcFunc> changeProcMapping_;
 
+    struct PendingUpdate {
+        UpdateRequest request;
+        int64_t eventTime;
+    };
+    // updates of process state waiting for the end of coalescing window, in order of arrival
+    std::mutex pendingUpdatesLock_;
+    std::vector<PendingUpdate> pendingUpdates_;
+    unsigned int updateCoalesceWindowMs_ = 0;
+    uint64_t coalescedUpdateCount_ = 0;
+    uint64_t coalescedApplyCount_ = 0;
+    unsigned int diedProcCheckCount_ = 0;
+
+    // delayed checks of processes share one wheel, only one tick task is in the queue of handler_
+    TimerWheel timerWheel_;
+    std::mutex timerWheelArmLock_;
+    int64_t timerWheelArmedMs_ = -1; // time the tick task is due, -1 if not posted
+    uint64_t timerWheelFiredCount_ = 0;
+    // ability start check timer of each process, guarded by totalBundlePrioSetLock_
+    std::unordered_map<pid_t, TimerWheel::TimerId> abilityStartTimers_;
+
     ReclaimPriorityManager();
     void InitUpdateReasonStrMapping();
     void InitChangeProcMapping();
     bool GetEventHandler();
-    void UpdateForegroundApps();
     bool IsFrontApp(const std::string& pkgName, int32_t uid, int32_t pid);
+    bool FetchForegroundApps(std::unordered_set<uint64_t> &foregroundApps);
     void GetAllKillableSystemApps();
     void GetKillableSystemAppsFromAms(std::set<std::string> &killableApps);
     void HandlePreStartedProcs();
     bool UpdateReclaimPriorityInner(UpdateRequest request, int64_t eventTime = INVALID_TIME);
+    bool HandleUpdateRequest(UpdateRequest &request, int64_t eventTime);
+    bool IsCoalescibleReason(AppStateUpdateReason reason);
+    bool PostCoalescedUpdate(const UpdateRequest &request, int64_t eventTime);
+    void FlushCoalescedUpdates();
+    void ApplyCoalescedUpdates(const std::vector<PendingUpdate> &updates);
+    void MarkBundlePrioSnapshotDirty();
     bool HandleExtensionProcess(UpdateRequest &request, int64_t eventTime);
     bool OsAccountChangedInner(int accountId, AccountSA::OS_ACCOUNT_SWITCH_MOD switchMod);
     bool UpdateAllPrioForOsAccountChanged(int accountId, AccountSA::OS_ACCOUNT_SWITCH_MOD switchMod);
     bool ApplyReclaimPriority(std::shared_ptr<BundlePriorityInfo> bundle, pid_t pid, AppAction action);
+    void NotifyReclaimStrategy(std::shared_ptr<BundlePriorityInfo> bundle, pid_t pid, AppAction action);
     bool IsProcExist(pid_t pid, int bundleUid, int accountId);
     bool IsOsAccountExist(int accountId);
     bool HandleCreateProcess(ReqProc &request, int accountId, bool isRender = false);
@@ -207,6 +246,8 @@ private:
     void RemoveOsAccountById(int accountId);
     void AddOsAccountInfo(std::shared_ptr<AccountBundleInfo> account);
     bool IsKillableSystemApp(std::shared_ptr<BundlePriorityInfo> bundle);
+    void InternKillableSystemApps();
+    void InternImportantProcs();
     void NotifyKillableSystemAppsAdded(std::set<std::string> &newKillableApps);
     void SetImportantProcPriority(ProcessPriorityInfo &proc);
     bool IsImportantProc(const std::string procName, int &dstPriority);
@@ -217,13 +258,18 @@ private:
     void SetTimerForDiedProcessCheck(int64_t delayTime);
     void FilterDiedProcess();
     void HandleDiedProcessCheck();
+    void HandleProcessExit(pid_t pid, int uid);
+    TimerWheel::TimerId AddTimer(int64_t delayMs, TimerWheel::Callback callback);
+    void ArmTimerWheel();
+    void HandleTimerWheelTick();
     void HandleDiedExtensionBindToMe(std::map<pid_t, ProcessPriorityInfo>::iterator processPriorityInfoMap,
         const std::vector<unsigned int> &alivePids);
     void HandleDiedExtensionBindFromMe(std::map<pid_t, ProcessPriorityInfo>::iterator processPriorityInfoMap,
         const std::vector<unsigned int> &alivePids);
-    void GetConnectedExtensionProc(const ProcessPriorityInfo &proc, ProcInfoVec &procVec);
-    void CalculateExtensionProcPrio(ProcInfoVec &proc, ProcInfoSet &procSet);
-    void SetConnectExtensionProcPrio(const ProcInfoSet &procSet);
+    ProcessPriorityInfo* FindExtensionGraphNode(pid_t pid, int32_t uid, std::shared_ptr<BundlePriorityInfo> &bundle);
+    int CalculateExtensionPriority(const ProcessPriorityInfo &extension);
+    // return true if priority of the extension is changed
+    bool ApplyExtensionPriority(ProcessPriorityInfo &extension, std::shared_ptr<BundlePriorityInfo> bundle);
 
     // two methods below used to manage totalBundlePrioSet_ by BundlePriorityInfo
     void AddBundleInfoToSet(std::shared_ptr<BundlePriorityInfo> bundle);
@@ -251,7 +297,7 @@ private:
     // these methods below used to check ability start completely
     bool HandleAbilityStart(const UpdateRequest &request, int64_t eventTime);
     bool CheckSatifyAbilityStartCondition(const ProcessPriorityInfo &proc);
-    void CheckAbilityStartCompleted(pid_t pid, int32_t bundleUid, int32_t accountId);
+    void CheckAbilityStartCompleted(pid_t pid, int32_t bundleUid, int32_t accountId, TimerWheel::TimerId timerId);
     void SetTimerForAbilityStartCompletedCheck(pid_t pid, int32_t bundleUid, int32_t accountId);
     void RemoveTimerForAbilityStartCompletedCheck(const ProcessPriorityInfo &proc);
     void FinishAbilityStartIfNeed(ProcessPriorityInfo &proc, AppStateUpdateReason reason, int64_t eventTime);
@@ -17,7 +17,7 @@
 #define OHOS_MEMORY_MEMCG_AVAIL_BUFFER_MANAGER_H
 
 #include "single_instance.h"
-#include "event_handler.h"
+#include "memmgr_executor.h"
 #include "reclaim_strategy_constants.h"
 #include "memmgr_config_manager.h"
 
@@ -42,7 +42,7 @@ public:
 
 private:
     bool initialized_ = false;
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
     unsigned int availBuffer_ = AVAIL_BUFFER; // default availBuffer 800MB
     unsigned int minAvailBuffer_ = MIN_AVAIL_BUFFER; // default minAvailBuffer 750MB
     unsigned int highAvailBuffer_ = HIGH_AVAIL_BUFFER; // default highAvailBuffer 850MB
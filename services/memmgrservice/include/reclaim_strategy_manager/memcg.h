@@ -16,7 +16,12 @@
 #ifndef OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_MEMCG_H
 #define OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_MEMCG_H
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
+
+#include "kv_file_reader.h"
 
 namespace OHOS {
 namespace Memory {
@@ -57,6 +62,15 @@ public:
     MemInfo& operator=(MemInfo&&) = delete;
 }; // end class MemInfo
 
+// fields of memory.stat used by memmgr
+struct MemcgStat {
+    long long anonKiB = 0;
+    long long zramKiB = 0;
+    long long eswapKiB = 0;
+    long long refaults = 0; // 0 if the kernel does not count refaults of memcg
+    bool refaultsValid = false; // refaults is read from memory.stat
+};
+
 class ReclaimRatios final {
 public:
     unsigned int mem2zramRatio_;
@@ -91,17 +105,47 @@ public:
     Memcg& operator=(Memcg&&) = delete;
 
     bool UpdateMemInfoFromKernel();
+    // read memory.stat in one pass, the file is kept open between reads
+    bool ReadMemcgStat(MemcgStat &stat);
+    // parse content of memory.stat, return false if any of anon, zram and eswap is missing
+    static bool ParseMemcgStat(const char *buf, size_t len, MemcgStat &stat);
 
     void SetScore(int score);
     void SetReclaimRatios(unsigned int mem2zramRatio, unsigned int zram2ufsRatio, unsigned int refaultThreshold);
     bool SetReclaimRatios(const ReclaimRatios& ratios);
+    // write score and ratios that differ from the ones last written, the kernel is not read back
     bool SetScoreAndReclaimRatiosToKernel();
+    // read score and ratios back from the kernel, and use them if they are not the ones last written.
+    // failed writes are retried. return false if the kernel can not be read or does not match.
+    bool ReconcileWithKernel();
     bool SwapIn(); // 100% load to mem
+    // move pids into the memcg with cgroup.procs opened once, return the count moved.
+    // with verify, cgroup.procs is read once at the end to check pids moved are still in it.
+    int AddProcs(const std::vector<unsigned int>& pids, bool verify = false);
     virtual std::string GetMemcgPath_();
 protected:
     bool WriteToFile_(const std::string& path, const std::string& content, bool truncated = true);
     bool ReadScoreAndReclaimRatiosFromKernel_(int& score, unsigned int& mem2zramRatio, unsigned int& zram2ufsRatio,
                                               unsigned int& refaultThreshold);
+    // count of pids not in cgroup.procs
+    int CountProcsMissing_(const std::string& procsPath, const std::vector<unsigned int>& pids);
+    // forget values written, for a memcg dir created again
+    void ResetAppliedParams_();
+private:
+    // score and ratios last written to the kernel successfully
+    struct AppliedParams {
+        bool scoreValid = false;
+        bool ratiosValid = false;
+        bool writeFailed = false;
+        int score = 0;
+        unsigned int mem2zramRatio = 0;
+        unsigned int zram2ufsRatio = 0;
+        unsigned int refaultThreshold = 0;
+    };
+    bool RatiosApplied_() const;
+
+    AppliedParams applied_;
+    std::unique_ptr<KvFileReader> statReader_; // created at the first read, path of memcg is virtual
 }; // end class Memcg
 
 class UserMemcg final : public Memcg {
@@ -121,6 +165,26 @@ public:
     bool AddProc(unsigned int pid);
     std::string GetMemcgPath_() final;
 }; // end class UserMemcg
+
+// memcg of one app under the memcg of its user, so score and ratios follow priority of the app
+class AppMemcg final : public Memcg {
+public:
+    unsigned int userId_;
+    int appUid_;
+
+    AppMemcg(unsigned int userId, int appUid);
+    ~AppMemcg();
+    AppMemcg() = delete;
+    AppMemcg(const AppMemcg&) = delete;
+    AppMemcg& operator=(const AppMemcg&) = delete;
+    AppMemcg(AppMemcg&&) = delete;
+    AppMemcg& operator=(AppMemcg&&) = delete;
+
+    bool CreateMemcgDir();
+    bool RemoveMemcgDir();
+    bool AddProc(unsigned int pid);
+    std::string GetMemcgPath_() final;
+}; // end class AppMemcg
 } // namespace Memory
 } // namespace OHOS
 #endif // OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_MEMCG_H
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "single_instance.h"
 #include "memcg.h"
@@ -39,13 +40,29 @@ public:
     bool RemoveUserMemcg(unsigned int userId);
     bool UpdateMemcgScoreAndReclaimRatios(unsigned int userId, int score, const ReclaimRatios& ratios);
     bool AddProcToMemcg(unsigned int pid, unsigned int userId);
+    // move pids of the user in one batch, return the count moved
+    int AddProcsToMemcg(const std::vector<unsigned int>& pids, unsigned int userId, bool verify = false);
     bool SwapInMemcg(unsigned int userId); // load memcg data 100% to mem
     SwapInfo* GetMemcgSwapInfo(unsigned int userId);
     MemInfo* GetMemcgMemInfo(unsigned int userId);
+    std::vector<unsigned int> GetUserIds() const;
+    // check score and ratios of all memcgs against the kernel, return the count not matched
+    int ReconcileMemcgs();
+
+    // app memcg operations, an app memcg is removed with its user memcg
+    AppMemcg* GetAppMemcg(int appUid);
+    AppMemcg* AddAppMemcg(unsigned int userId, int appUid);
+    bool RemoveAppMemcg(int appUid);
+    // fall back to the user memcg if the app memcg can not be created
+    bool AddProcToAppMemcg(unsigned int pid, unsigned int userId, int appUid);
+    bool UpdateAppMemcgScoreAndReclaimRatios(int appUid, int score, const ReclaimRatios& ratios);
+    std::vector<int> GetAppUids() const;
 private:
     MemcgMgr();
+    void RemoveAppMemcgsOfUser(unsigned int userId);
     Memcg* rootMemcg_;
     std::map<int, UserMemcg*> userMemcgsMap_; // map<userId, UserMemcg*>
+    std::map<int, AppMemcg*> appMemcgsMap_; // map<appUid, AppMemcg*>
 }; // end class MemcgMgr
 } // namespace Memory
 } // namespace OHOS
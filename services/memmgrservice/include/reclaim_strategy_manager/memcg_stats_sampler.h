@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_MEMCG_STATS_SAMPLER_H
+#define OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_MEMCG_STATS_SAMPLER_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "memcg.h"
+#include "memmgr_executor.h"
+#include "reclaim_strategy_constants.h"
+#include "single_instance.h"
+
+namespace OHOS {
+namespace Memory {
+struct MemcgStatsSample {
+    int64_t timeMs = 0; // steady clock
+    MemcgStat stat;
+    // change since the previous sample of the same memcg, 0 for the first one
+    long long anonDeltaKiB = 0;
+    long long zramDeltaKiB = 0;
+    long long eswapDeltaKiB = 0;
+    long long refaultDelta = 0;
+};
+
+/*
+ * Samples memory.stat of every user and app memcg periodically and keeps the last samples of each.
+ * Sampling runs on the handler owning MemcgMgr, readers such as reclaim tuning and dumps
+ * may be on any thread and never touch the kernel files.
+ */
+class MemcgStatsSampler {
+    DECLARE_SINGLE_INSTANCE(MemcgStatsSampler);
+public:
+    // called on the handler after each round with users and apps sampled
+    using RoundCallback = std::function<void(const std::vector<unsigned int> &userIds,
+        const std::vector<int> &appUids)>;
+
+    // handler must be the one all MemcgMgr operations run on, periodMs 0 disables sampling
+    void Start(std::shared_ptr<LaneHandler> handler, unsigned int periodMs, unsigned int sampleCount);
+    void Stop();
+    void SetRoundCallback(RoundCallback callback);
+    // sample all user and app memcgs once, called on the handler
+    void SampleAll();
+    // memcgs not in userIds are dropped
+    void RetainMemcgs(const std::vector<unsigned int> &userIds);
+    void RetainAppMemcgs(const std::vector<int> &appUids);
+    void AddSample(unsigned int userId, int64_t timeMs, const MemcgStat &stat);
+    void AddAppSample(int appUid, int64_t timeMs, const MemcgStat &stat);
+    bool GetLatestSample(unsigned int userId, MemcgStatsSample &sample);
+    // samples of the memcg from the oldest to the latest
+    std::vector<MemcgStatsSample> GetSamples(unsigned int userId);
+    std::vector<MemcgStatsSample> GetAppSamples(int appUid);
+    void Dump(int fd);
+
+private:
+    void ScheduleNext();
+    void AppendSampleLocked(std::deque<MemcgStatsSample> &samples, int64_t timeMs, const MemcgStat &stat);
+
+    std::mutex lock_;
+    std::shared_ptr<LaneHandler> handler_;
+    unsigned int periodMs_ = 0;
+    unsigned int sampleCount_ = MEMCG_STATS_SAMPLE_COUNT;
+    uint64_t roundCount_ = 0;
+    RoundCallback roundCallback_;
+    std::map<unsigned int, std::deque<MemcgStatsSample>> samples_; // map<userId, samples>
+    std::map<int, std::deque<MemcgStatsSample>> appSamples_; // map<appUid, samples>
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_MEMCG_STATS_SAMPLER_H
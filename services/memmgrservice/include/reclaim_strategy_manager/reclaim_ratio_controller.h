@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_RECLAIM_RATIO_CONTROLLER_H
+#define OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_RECLAIM_RATIO_CONTROLLER_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "memcg.h"
+#include "memcg_stats_sampler.h"
+#include "reclaim_config.h"
+#include "single_instance.h"
+
+namespace OHOS {
+namespace Memory {
+/*
+ * Moves reclaim ratios of user and app memcgs around the ratios of config by the refault rate of
+ * each memcg. A memcg refaulting faster than refaultHigh is reclaimed less, and a memcg
+ * with compressed pages refaulting slower than refaultLow is reclaimed more. The offset
+ * is changed by step after each sampling round and never goes beyond maxOffset.
+ * All methods but Dump run on the reclaim lane.
+ */
+class ReclaimRatioController {
+    DECLARE_SINGLE_INSTANCE(ReclaimRatioController);
+public:
+    void Init(const RatioControllerConfig &config);
+    // ratios of config for the score of the memcg, the current offset is applied to them
+    void SetBaseRatios(unsigned int userId, ReclaimRatios &ratios);
+    void SetAppBaseRatios(int appUid, ReclaimRatios &ratios);
+    // adjust by the latest samples, memcgs not in userIds or appUids are forgotten
+    void Update(const std::vector<unsigned int> &userIds, const std::vector<int> &appUids);
+    int GetOffset(unsigned int userId);
+    int GetAppOffset(int appUid);
+    // offset of next round for the refault rate and the compressed size of a memcg,
+    // 0 if the kernel does not count refaults of memcg
+    static int NextOffset(int offset, long long refaultsPerSec, const MemcgStat &stat,
+        const RatioControllerConfig &config);
+    void Dump(int fd);
+
+private:
+    struct MemcgState {
+        unsigned int mem2zramRatio = 0;
+        unsigned int zram2ufsRatio = 0;
+        unsigned int refaultThreshold = 0;
+        int offset = 0;
+        long long refaultsPerSec = 0;
+        uint64_t adjustCount = 0;
+    };
+    static unsigned int ApplyOffset(unsigned int ratio, int offset);
+    static MemcgState MakeState(const ReclaimRatios &ratios);
+    static void SetBaseRatiosOfState(MemcgState &state, ReclaimRatios &ratios);
+    // move the offset by the latest two samples, return true if it is changed
+    bool AdjustOffset(MemcgState &state, const std::vector<MemcgStatsSample> &samples);
+
+    std::mutex lock_;
+    RatioControllerConfig config_;
+    std::map<unsigned int, MemcgState> states_; // map<userId, MemcgState>
+    std::map<int, MemcgState> appStates_; // map<appUid, MemcgState>
+};
+} // namespace Memory
+} // namespace OHOS
+#endif // OHOS_MEMORY_MEMMGR_RECLAIM_STRATEGY_RECLAIM_RATIO_CONTROLLER_H
@@ -39,6 +39,18 @@ constexpr int RECLAIM_SCORE_MIN = 0;
 constexpr int RECLAIM_SCORE_MAX = 1000;
 // min value of user id
 constexpr int VALID_USER_ID_MIN = 100;
+// sampling of memory.stat of user memcgs, period 0 disables it
+constexpr unsigned int MEMCG_STATS_SAMPLE_PERIOD_MS = 10000;
+constexpr unsigned int MEMCG_STATS_MIN_SAMPLE_PERIOD_MS = 1000;
+constexpr unsigned int MEMCG_STATS_SAMPLE_COUNT = 8;
+constexpr unsigned int MEMCG_STATS_MAX_SAMPLE_COUNT = 64;
+// adaptive reclaim ratios, offset in percent added to ratios of config, max offset 0 disables it
+constexpr unsigned int RATIO_CONTROLLER_MAX_OFFSET = 0;
+constexpr unsigned int RATIO_CONTROLLER_STEP = 5;
+constexpr unsigned int RATIO_CONTROLLER_REFAULT_HIGH = 200; // refaults per second
+constexpr unsigned int RATIO_CONTROLLER_REFAULT_LOW = 10; // refaults per second
+// score and ratios written are read back from the kernel at this period
+constexpr unsigned int MEMCG_RECONCILE_PERIOD_MS = 60000;
 } // namespace Memory
 } // namespace OHOS
 #endif // OHOS_MEMORY_MEMMGR_RECALIM_STRATEGY_CONSTANTS_H
@@ -17,7 +17,7 @@
 #define OHOS_MEMORY_MEMMGR_RECALIM_STRATEGY_MANAGER_H
 
 #include "single_instance.h"
-#include "event_handler.h"
+#include "memmgr_executor.h"
 #include "memcg_mgr.h"
 #include "reclaim_param.h"
 
@@ -37,18 +37,20 @@ public:
         return initialized_;
     };
     //this method is only used for class PurgeableMemManager
-    std::shared_ptr<AppExecFwk::EventHandler> GetEventHandler() const;
+    std::shared_ptr<LaneHandler> GetEventHandler() const;
 private:
     bool initialized_ = false;
-    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<LaneHandler> handler_;
 
     ReclaimStrategyManager();
     bool CreateEventHandler();
     void InitProcessBeforeMemmgr();
+    void ScheduleMemcgReconcile_();
 
     // handle app and os user event
     bool HandleAppStateChanged_(std::shared_ptr<ReclaimParam> reclaimPara);
     bool HandleProcessCreate_(std::shared_ptr<ReclaimParam> reclaimPara);
+    bool HandleAppPriorityChanged_(std::shared_ptr<ReclaimParam> reclaimPara);
     bool HandleAccountDied_(int accountId);
     bool HandleAccountPriorityChanged_(int accountId, int priority);
 
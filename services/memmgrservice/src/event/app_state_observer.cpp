@@ -14,6 +14,7 @@
  */
 
 #include "app_state_observer.h"
+#include "app_mgr_constants.h"
 #include "mem_mgr_event_center.h"
 #include "memmgr_log.h"
 #include "reclaim_priority_manager.h"
@@ -33,6 +34,8 @@ void AppStateObserver::OnForegroundApplicationChanged(const AppExecFwk::AppState
     // no pid here !
     HILOGI("uid=%{public}d, bundleName=%{public}s, state=%{public}d, ",
         appStateData.uid, appStateData.bundleName.c_str(), appStateData.state);
+    ReclaimPriorityManager::GetInstance().NotifyForegroundAppChanged(appStateData.uid, appStateData.bundleName,
+        appStateData.state == static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_FOREGROUND));
 #ifdef USE_PURGEABLE_MEMORY
     PurgeableMemManager::GetInstance().ChangeAppState(appStateData.pid, appStateData.uid, appStateData.state);
 #endif
@@ -16,6 +16,7 @@
 #include "common_event_observer.h"
 #include "memmgr_log.h"
 #include "memmgr_ptr_util.h"
+#include "reclaim_priority_manager.h"
 
 #include "common_event.h"
 #include "common_event_manager.h"
@@ -25,6 +26,7 @@ namespace OHOS {
 namespace Memory {
 namespace {
 const std::string TAG = "CommonEventObserver";
+const std::string PACKAGE_EVENT_UID_KEY = "uid";
 }
 
 CommonEventObserver::CommonEventObserver(const EventFwk::CommonEventSubscribeInfo &subscriberInfo)
@@ -41,6 +43,12 @@ void CommonEventObserver::OnReceiveEvent(const EventFwk::CommonEventData &eventD
     auto want = eventData.GetWant();
     std::string action = want.GetAction();
     HILOGI("action=<%{public}s>", action.c_str());
+    if (action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED ||
+        action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED ||
+        action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED ||
+        action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REPLACED) {
+        ReclaimPriorityManager::GetInstance().NotifyPackageChanged(want.GetIntParam(PACKAGE_EVENT_UID_KEY, -1));
+    }
 }
 } // namespace Memory
 } // namespace OHOS
@@ -21,8 +21,8 @@
 #include <sys/epoll.h>
 #include <unistd.h>
 
+#include "epoll_reactor.h"
 #include "memmgr_log.h"
-#include "memmgr_ptr_util.h"
 #include "memory_level_constants.h"
 #ifdef USE_PURGEABLE_MEMORY
 #include "purgeable_mem_manager.h"
@@ -36,35 +36,18 @@ const std::string TAG = "KswapdObserver";
 
 KswapdObserver::KswapdObserver()
 {
-    MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return,
-                 AppExecFwk::EventRunner::Create());
-    HILOGI("handler init success!");
 }
 
 void KswapdObserver::Init()
 {
-    epollfd_ = epoll_create(6); // 6 : max epoll events
-    if (epollfd_ == -1) {
-        HILOGE("epoll_create failed (errno=%{public}d)", errno);
-        return;
-    }
-    HILOGI("epoll_create success epollfd_=<%{public}d>", epollfd_);
-
     if (!RegisterKswapdListener()) {
         HILOGE("register kswapd pressure failed!");
         return;
     }
-    // call MainLoop at handler thread
-    if (handler_ != nullptr) {
-        handler_->PostImmediateTask([this] { this->MainLoop(); });
-        HILOGD("call MainLoop at handler thread");
-    }
 }
 
 bool KswapdObserver::RegisterKswapdListener()
 {
-    struct epoll_event epollEvent;
-
     // open file
     do {
         kswapdMonitorFd_ = open(KSWAPD_PRESSURE_FILE, O_WRONLY | O_CLOEXEC);
@@ -74,63 +57,42 @@ bool KswapdObserver::RegisterKswapdListener()
         return false;
     }
 
-    epollEvent.events = EPOLLPRI;
-    epollEvent.data.ptr = nullptr;
-    epollEvent.data.fd = kswapdMonitorFd_;
-    if (epoll_ctl(epollfd_, EPOLL_CTL_ADD, kswapdMonitorFd_, &epollEvent) < 0) {
+    if (!EpollReactor::GetInstance().AddFd(kswapdMonitorFd_, EPOLLPRI, ReactorPriority::NORMAL, TAG,
+        [this](int fd, uint32_t events) { this->HandleKswapdEvent(fd, events); })) {
         close(kswapdMonitorFd_);
         kswapdMonitorFd_ = -1;
-        HILOGE("failed to add file fd to epoll : errno=%{public}d", errno);
+        HILOGE("failed to watch kswapd monitor fd");
         return false;
     }
     HILOGI("fd for kswapd monitor = %{public}d", kswapdMonitorFd_);
     return true;
 }
 
-void KswapdObserver::MainLoop(void)
+void KswapdObserver::HandleKswapdEvent(int fd, uint32_t events)
 {
-    struct epoll_event *curEpollEvent;
-
-    while (1) {
-        HILOGD("waiting for epoll event ...");
-        struct epoll_event events[1];
-        int i;
-        int nevents = epoll_wait(epollfd_, events, 1, -1);
-        HILOGD("receive events, num=%{public}d!", nevents);
-        if (nevents == -1) {
-            if (errno == EINTR) {
-                continue;
-            }
-            HILOGE("failed to wait epoll event(errno=%{public}d)", errno);
-            continue;
-        }
-
-        for (i = 0, curEpollEvent = &events[0]; i < nevents; ++i, curEpollEvent++) {
-            if (curEpollEvent->events & EPOLLHUP) {
-                HILOGE("EPOLLHUP in events[%{public}d]", i);
-                HandleEventEpollHup(curEpollEvent);
-                continue;
-            }
-            if (curEpollEvent->events & EPOLLERR) {
-                HILOGE("epoll err in events[%{public}d]", i);
-                continue;
-            }
-            if ((curEpollEvent->events & EPOLLPRI) && curEpollEvent->data.fd == kswapdMonitorFd_) {
-                HandleKswapdReport();
-            }
-        } // end of for
-    } // end of while
+    if (events & EPOLLHUP) {
+        HILOGE("EPOLLHUP of kswapd monitor fd");
+        HandleEventEpollHup(fd);
+        return;
+    }
+    if (events & EPOLLERR) {
+        HILOGE("epoll err of kswapd monitor fd");
+        return;
+    }
+    if ((events & EPOLLPRI) && fd == kswapdMonitorFd_) {
+        HandleKswapdReport();
+    }
 }
 
-void KswapdObserver::HandleEventEpollHup(struct epoll_event *curEpollEvent)
+void KswapdObserver::HandleEventEpollHup(int fd)
 {
-    if (epoll_ctl(epollfd_, EPOLL_CTL_DEL, curEpollEvent->data.fd, NULL) < 0) {
-        HILOGE("Failed to unmonitor for kswapd, errno=%{public}d", errno);
+    if (!EpollReactor::GetInstance().RemoveFd(fd)) {
+        HILOGE("Failed to unmonitor for kswapd");
     }
-    if (curEpollEvent->data.fd >= 0) {
-        close(curEpollEvent->data.fd);
+    if (fd >= 0) {
+        close(fd);
     }
-    if (curEpollEvent->data.fd == kswapdMonitorFd_) {
+    if (fd == kswapdMonitorFd_) {
         kswapdMonitorFd_ = -1;
     }
 }
@@ -147,12 +109,9 @@ void HandleKswapdReport()
 KswapdObserver::~KswapdObserver()
 {
     if (kswapdMonitorFd_ >= 0) {
-        epoll_ctl(epollfd_, EPOLL_CTL_DEL, kswapdMonitorFd_, NULL);
+        EpollReactor::GetInstance().RemoveFd(kswapdMonitorFd_);
         close(kswapdMonitorFd_);
     }
-    if (epollfd_ >= 0) {
-        close(epollfd_);
-    }
 }
 } // namespace Memory
 } // namespace OHOS
@@ -18,6 +18,8 @@
 #include "memmgr_log.h"
 #include "memmgr_ptr_util.h"
 #include "common_event_observer.h"
+#include "epoll_reactor.h"
+#include "psi_event_dispatcher.h"
 #include "reclaim_priority_manager.h"
 #include "window_visibility_observer.h"
 #ifdef CONFIG_BGTASK_MGR
@@ -31,7 +33,6 @@ namespace OHOS {
 namespace Memory {
 namespace {
 const std::string TAG = "MemMgrEventCenter";
-const std::string MEMMGR_CENTER_HANDLER = "MemMgrEventCenterHandler";
 const int ACCOUNT_MAX_RETRY_TIMES = 10;
 const int ACCOUNT_RETRY_DELAY = 3000;
 const int EXTCONN_RETRY_TIME = 1000;
@@ -55,8 +56,8 @@ bool MemMgrEventCenter::Init()
 bool MemMgrEventCenter::CreateRegisterHandler()
 {
     if (!regObsHandler_) {
-        MAKE_POINTER(regObsHandler_, shared, AppExecFwk::EventHandler, "failed to create register handler",
-        return false, AppExecFwk::EventRunner::Create(MEMMGR_CENTER_HANDLER));
+        MAKE_POINTER(regObsHandler_, shared, LaneHandler, "failed to create register handler",
+        return false, ExecutorLane::BOOKKEEPING);
     }
     return true;
 }
@@ -158,6 +159,8 @@ void MemMgrEventCenter::RegisterAppStateObserver()
         int ret = appObject->RegisterApplicationStateObserver(appStateObserver_);
         if (ret == ERR_OK) {
             HILOGI("register success");
+            // changes before the observer is registered are missed, take the whole list once
+            ReclaimPriorityManager::GetInstance().UpdateForegroundApps();
             return;
         }
         HILOGE("register fail, ret = %{public}d", ret);
@@ -211,6 +214,10 @@ void MemMgrEventCenter::RegisterCommonEventObserver()
     matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_POWER_DISCONNECTED);
     matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_ON);
     matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_OFF);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REPLACED);
     EventFwk::CommonEventSubscribeInfo commonEventSubscribeInfo(matchingSkills);
     MAKE_POINTER(commonEventObserver_, shared, CommonEventObserver, "make unique failed",
         return, commonEventSubscribeInfo);
@@ -308,6 +315,9 @@ void MemMgrEventCenter::Dump(int fd)
     dprintf(fd, "-----------------------------------------------------------------\n");
     dprintf(fd, "%30s %8s\n", "CommonEventObserver", commonEventObserver_ == nullptr ? "N" : "Y");
     dprintf(fd, "-----------------------------------------------------------------\n");
+    PsiEventDispatcher::GetInstance().Dump(fd);
+    EpollReactor::GetInstance().Dump(fd);
+    MemMgrExecutor::GetInstance().Dump(fd);
 }
 
 void MemMgrEventCenter::RetryRegisterEventObserver(int32_t systemAbilityId)
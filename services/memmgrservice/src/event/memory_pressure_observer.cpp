@@ -14,8 +14,9 @@
  */
 
 #include "memory_pressure_observer.h"
+#include "epoll_reactor.h"
+#include "memmgr_config_manager.h"
 #include "memmgr_log.h"
-#include "memmgr_ptr_util.h"
 #include "low_memory_killer.h"
 #include "memory_level_manager.h"
 
@@ -35,49 +36,50 @@ const int MAX_CMD_LINE_LENGTH = 256;
 MemoryPressureObserver::MemoryPressureObserver()
 {
     HILOGI("called");
-    MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return,
-        AppExecFwk::EventRunner::Create());
-    HILOGE("handler init success!");
 }
 
 void MemoryPressureObserver::Init()
 {
     HILOGI("called");
-    epollfd_ = epoll_create(6); // 6 : max epoll events
-    if (epollfd_ == -1) {
-        HILOGE("epoll_create failed (errno=%{public}d)", errno);
-        return;
+    const PsiConfig::PsiTriggerList &triggers = MemmgrConfigManager::GetInstance().GetPsiConfig().GetPsiTriggers();
+    levelConfigs_.clear();
+    for (size_t level = 0; level < triggers.size(); level++) {
+        MemPressLevelCfg levelConfig = {static_cast<int>(level), triggers[level].stallType,
+            static_cast<int>(triggers[level].thresholdMs), static_cast<int>(triggers[level].windowMs),
+            -1};
+        levelConfigs_.push_back(levelConfig);
     }
-    HILOGI("epoll_create success epollfd_=<%{public}d>", epollfd_);
-
-    if (!MonitorLevel(MemPressureLevel::LEVEL_0)) {
-        HILOGE("register memory pressure low level failed!");
+    for (size_t level = 0; level < levelConfigs_.size(); level++) {
+        if (!MonitorLevel(static_cast<int>(level))) {
+            HILOGE("register memory pressure level %{public}zu failed!", level);
+        }
+    }
+    if (curLevelCount_ == 0) {
+        HILOGE("no memory pressure level registered!");
         return;
     }
-    // call MainLoop at handler thread
-    handler_->PostImmediateTask([this] { this->MainLoop(); });
-    HILOGI("call MainLoop at handler thread");
+    HILOGI("%{public}d memory pressure levels registered", curLevelCount_);
 }
 
-bool MemoryPressureObserver::MonitorLevel(MemPressureLevel level)
+bool MemoryPressureObserver::MonitorLevel(int level)
 {
-    int fd = CreateLevelFileFd(levelConfigArr[level].stallType,
-                               levelConfigArr[level].thresholdInMs * US_PER_MS,
-                               WINDOW_IN_MS * US_PER_MS);
+    MemPressLevelCfg &levelConfig = levelConfigs_[level];
+    int fd = CreateLevelFileFd(levelConfig.stallType,
+                               levelConfig.thresholdInMs * US_PER_MS,
+                               levelConfig.windowInMs * US_PER_MS);
     HILOGI("fd for level %{public}d = %{public}d", level, fd);
     if (fd < 0) {
         return false;
     }
 
-    levelConfigArr[level].levelHandler.handler = HandleLevelReport;
-    levelConfigArr[level].levelHandler.data = level;
-    if (AddLevelFileFdToEpoll(epollfd_, fd, &levelConfigArr[level].levelHandler) < 0) {
+    levelConfig.levelFileFd = fd;
+    if (!EpollReactor::GetInstance().AddFd(fd, EPOLLPRI, ReactorPriority::URGENT, TAG + std::to_string(level),
+        [this, level](int, uint32_t events) { this->HandleLevelEvent(level, events); })) {
         CloseLevelFileFd(fd);
-        levelConfigArr[level].levelFileFd = -1;
+        levelConfig.levelFileFd = -1;
         return false;
     }
     curLevelCount_++;
-    levelConfigArr[level].levelFileFd = fd;
 
     return true;
 }
@@ -133,95 +135,51 @@ err:
     return -1;
 }
 
-int MemoryPressureObserver::AddLevelFileFdToEpoll(int epollfd, int fd, void* data)
+void MemoryPressureObserver::HandleLevelEvent(int level, uint32_t events)
 {
-    int ret;
-    struct epoll_event epollEvent;
-
-    epollEvent.events = EPOLLPRI;
-    epollEvent.data.ptr = data;
-    ret = epoll_ctl(epollfd, EPOLL_CTL_ADD, fd, &epollEvent);
-    if (ret < 0) {
-        HILOGE("failed to add file fd to epoll ; errno=%{public}d", errno);
+    if (events & EPOLLHUP) {
+        HILOGE("disconnected!");
+        UnMonitorLevel(level);
+        return;
     }
-    return ret;
-}
-
-void MemoryPressureObserver::MainLoop(void)
-{
-    HILOGE("enter");
-    struct epoll_event *curEpollEvent;
-
-    while (1) {
-        HILOGD("waiting for epoll event ...");
-        struct epoll_event events[curLevelCount_];
-        int i;
-        int nevents = epoll_wait(epollfd_, events, curLevelCount_, -1);
-        if (nevents == -1) {
-            if (errno == EINTR)
-                continue;
-            HILOGE("failed to wait epoll event(errno=%{public}d)", errno);
-            continue;
-        }
-
-        for (i = 0, curEpollEvent = &events[0]; i < nevents; ++i, curEpollEvent++) {
-            if ((curEpollEvent->events & EPOLLHUP) && curEpollEvent->data.ptr) {
-                HILOGE("disconnected!");
-                handlerInfo_ = (struct LevelHandler*)curEpollEvent->data.ptr;
-                int level = handlerInfo_->data;
-                UnMonitorLevel(levelConfigArr[level].level);
-                continue;
-            }
-            if (curEpollEvent->events & EPOLLERR)
-                HILOGE("epoll err in events[%{public}d]", i);
-            if (curEpollEvent->data.ptr) {
-                HandleEpollEvent(curEpollEvent);
-            }
-        } // end of for
-    } // end of while
-}
-
-void MemoryPressureObserver::HandleEpollEvent(struct epoll_event *curEpollEvent)
-{
-    handlerInfo_ = (struct LevelHandler*)curEpollEvent->data.ptr;
-    HILOGD("#2 call handler");
-    handlerInfo_->handler(handlerInfo_->data, curEpollEvent->events);
+    if (events & EPOLLERR) {
+        HILOGE("epoll err of level %{public}d", level);
+    }
+    HandleLevelReport(level, events);
 }
 
 void HandleLevelReport(int level, uint32_t events)
 {
     HILOGI("level=%{public}d !", level);
-    MemoryLevelManager::GetInstance().PsiHandler();
-    LowMemoryKiller::GetInstance().PsiHandler();
+    MemoryLevelManager::GetInstance().PsiHandler(level);
+    LowMemoryKiller::GetInstance().PsiHandler(level);
 }
 
 MemoryPressureObserver::~MemoryPressureObserver()
 {
     HILOGI("called");
-    UnMonitorLevel(MemPressureLevel::LEVEL_0);
-    if (epollfd_ >= 0) {
-        close(epollfd_);
+    for (size_t level = 0; level < levelConfigs_.size(); level++) {
+        if (levelConfigs_[level].levelFileFd >= 0) {
+            UnMonitorLevel(static_cast<int>(level));
+        }
     }
 }
 
-void MemoryPressureObserver::UnMonitorLevel(MemPressureLevel level)
+void MemoryPressureObserver::UnMonitorLevel(int level)
 {
-    int fd = levelConfigArr[level].levelFileFd;
+    int fd = levelConfigs_[level].levelFileFd;
+    if (fd < 0) {
+        return;
+    }
 
-    if (delLevelFileFdFromEpoll(epollfd_, fd) < 0) {
-        HILOGE("Failed to unmonitor for level %{public}d, errno=%{public}d",
-            level, errno);
+    if (!EpollReactor::GetInstance().RemoveFd(fd)) {
+        HILOGE("Failed to unmonitor for level %{public}d", level);
     }
     CloseLevelFileFd(fd);
-    levelConfigArr[level].levelFileFd = -1;
+    levelConfigs_[level].levelFileFd = -1;
     curLevelCount_--;
 }
 
-int MemoryPressureObserver::delLevelFileFdFromEpoll(int epollfd, int fd)
-{
-    return epoll_ctl(epollfd, EPOLL_CTL_DEL, fd, NULL);
-}
-
 void MemoryPressureObserver::CloseLevelFileFd(int fd)
 {
     if (fd >= 0) {
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "psi_event_dispatcher.h"
+
+#include <cstdio>
+
+#include "memmgr_log.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "PsiEventDispatcher";
+}
+
+IMPLEMENT_SINGLE_INSTANCE(PsiEventDispatcher);
+
+PsiEventDispatcher::Consumer::Consumer(std::shared_ptr<LaneHandler> handler, ConsumerFunc func)
+    : handler_(handler), func_(func)
+{
+}
+
+void PsiEventDispatcher::Consumer::Dispatch(int level)
+{
+    // publish the level before the generation, so the evaluation noticing the event sees its level
+    int pending = pendingLevel_.load();
+    while (level > pending && !pendingLevel_.compare_exchange_weak(pending, level)) {
+    }
+    generation_.fetch_add(1);
+    if (scheduled_.exchange(true)) {
+        merged_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!Post()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool PsiEventDispatcher::Consumer::Post()
+{
+    auto self = shared_from_this();
+    if (handler_ != nullptr && handler_->PostImmediateTask([self] { self->Run(); })) {
+        return true;
+    }
+    scheduled_.store(false);
+    return false;
+}
+
+void PsiEventDispatcher::Consumer::Run()
+{
+    uint64_t generation = generation_.load();
+    int level = pendingLevel_.exchange(0);
+    runs_.fetch_add(1, std::memory_order_relaxed);
+    lastLevel_.store(level, std::memory_order_relaxed);
+    func_(level);
+    scheduled_.store(false);
+    // events came during the evaluation, evaluate once more on fresh data for all of them
+    if (generation_.load() != generation && !scheduled_.exchange(true) && !Post()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+PsiConsumerStats PsiEventDispatcher::Consumer::GetStats() const
+{
+    PsiConsumerStats stats;
+    stats.events = generation_.load(std::memory_order_relaxed);
+    stats.runs = runs_.load(std::memory_order_relaxed);
+    stats.merged = merged_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.lastLevel = lastLevel_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool PsiEventDispatcher::AddConsumer(const std::string &name, std::shared_ptr<LaneHandler> handler,
+    ConsumerFunc func)
+{
+    if (handler == nullptr || func == nullptr) {
+        HILOGE("invalid consumer %{public}s", name.c_str());
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(consumersLock_);
+    auto ret = consumers_.emplace(name, std::make_shared<Consumer>(handler, func));
+    if (!ret.second) {
+        HILOGE("consumer %{public}s is added already", name.c_str());
+        return false;
+    }
+    HILOGI("consumer %{public}s added", name.c_str());
+    return true;
+}
+
+std::shared_ptr<PsiEventDispatcher::Consumer> PsiEventDispatcher::FindConsumer(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(consumersLock_);
+    auto it = consumers_.find(name);
+    return it == consumers_.end() ? nullptr : it->second;
+}
+
+bool PsiEventDispatcher::Dispatch(const std::string &name, int level)
+{
+    std::shared_ptr<Consumer> consumer = FindConsumer(name);
+    if (consumer == nullptr) {
+        HILOGE("consumer %{public}s not found", name.c_str());
+        return false;
+    }
+    consumer->Dispatch(level);
+    return true;
+}
+
+bool PsiEventDispatcher::GetConsumerStats(const std::string &name, PsiConsumerStats &stats)
+{
+    std::shared_ptr<Consumer> consumer = FindConsumer(name);
+    if (consumer == nullptr) {
+        return false;
+    }
+    stats = consumer->GetStats();
+    return true;
+}
+
+void PsiEventDispatcher::Dump(int fd)
+{
+    std::lock_guard<std::mutex> lock(consumersLock_);
+    dprintf(fd, "psi event consumers\n");
+    dprintf(fd, "                          name       events         runs       merged      dropped lastLevel\n");
+    for (auto &pair : consumers_) {
+        PsiConsumerStats stats = pair.second->GetStats();
+        dprintf(fd, "%30s %12llu %12llu %12llu %12llu %9d\n", pair.first.c_str(),
+            static_cast<unsigned long long>(stats.events), static_cast<unsigned long long>(stats.runs),
+            static_cast<unsigned long long>(stats.merged), static_cast<unsigned long long>(stats.dropped),
+            stats.lastLevel);
+    }
+    dprintf(fd, "-----------------------------------------------------------------\n");
+}
+} // namespace Memory
+} // namespace OHOS
@@ -36,8 +36,8 @@ IMPLEMENT_SINGLE_INSTANCE(WindowVisibilityObserver);
 WindowVisibilityObserver::WindowVisibilityObserver()
 {
     if (!handler_) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return,
-                     AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return,
+                     ExecutorLane::BOOKKEEPING);
     }
     SetTimer();
 }
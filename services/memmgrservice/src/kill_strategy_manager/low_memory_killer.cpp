@@ -17,6 +17,8 @@
 #include "memmgr_log.h"
 #include "memmgr_ptr_util.h"
 #include "kernel_interface.h"
+#include "process_handle_table.h"
+#include "psi_event_dispatcher.h"
 #include "reclaim_priority_manager.h"
 
 namespace OHOS {
@@ -25,7 +27,11 @@ namespace {
     const std::string TAG = "LowMemoryKiller";
     const int LOW_MEM_KILL_LEVELS = 5;
     const int MAX_KILL_CNT_PER_EVENT = 3;
+    // more bundles may be killed for one event when it is reported by a more urgent psi level
+    const int KILL_CNT_STEP_PER_PSI_LEVEL = 2;
     const int NOT_TO_KILL_DURING = 3;
+    // max time to wait for killed processes to exit before checking buffer again
+    const int WAIT_KILLED_PROC_EXIT_MS = 100;
     /*
      * LMKD_DBG_TRIGGER_FILE_PATH:
      * print process meminfo when write 0/1 to the file,
@@ -53,7 +59,8 @@ static int g_minPrioTable[LOW_MEM_KILL_LEVELS][static_cast<int32_t>(MinPrioField
 
 LowMemoryKiller::LowMemoryKiller()
 {
-    initialized_ = GetEventHandler();
+    initialized_ = GetEventHandler() && PsiEventDispatcher::GetInstance().AddConsumer(TAG, handler_,
+        [this](int level) { this->PsiHandlerInner(level); });
     if (initialized_) {
         HILOGI("init successed");
     } else {
@@ -64,8 +71,8 @@ LowMemoryKiller::LowMemoryKiller()
 bool LowMemoryKiller::GetEventHandler()
 {
     if (!handler_) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
-            AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return false,
+            ExecutorLane::KILL);
     }
     return true;
 }
@@ -75,49 +82,67 @@ int32_t LowMemoryKiller::GetKillLevel()
     return killLevel_;
 }
 
+int LowMemoryKiller::KillOneProcess(pid_t pid)
+{
+    int freedKB = 0;
+    // kill through pidfd if the process is managed, avoid reading procfs and pid reuse
+    if (ProcessHandleTable::GetInstance().KillProcess(pid, freedKB)) {
+        return freedKB;
+    }
+    HILOGW("pid=%{public}d is not managed, kill it by pid", pid);
+    return KernelInterface::GetInstance().KillOneProcessByPid(pid);
+}
+
 int LowMemoryKiller::KillOneBundleByPrio(int minPrio)
+{
+    std::vector<pid_t> killedPids;
+    std::unordered_set<int> killedUids;
+    return KillOneBundleByPrio(minPrio, killedPids, killedUids);
+}
+
+int LowMemoryKiller::KillOneBundleByPrio(int minPrio, std::vector<pid_t> &killedPids,
+    std::unordered_set<int> &killedUids)
 {
     HILOGE("called. minPrio=%{public}d", minPrio);
     int freedBuf = 0;
-    ReclaimPriorityManager::BunldeCopySet bundles;
-
-    ReclaimPriorityManager::GetInstance().GetOneKillableBundle(minPrio, bundles);
-    HILOGD("get BundlePrioSet size=%{public}zu", bundles.size());
+    BundlePrioritySnapshotPtr snapshot = ReclaimPriorityManager::GetInstance().GetBundlePrioSnapshot();
+    HILOGD("get BundlePrioSnapshot version=%{public}llu size=%{public}zu",
+        static_cast<unsigned long long>(snapshot->GetVersion()), snapshot->Size());
 
     int count = 0;
-    for (auto bundle : bundles) {
+    for (auto &bundle : snapshot->GetBundles()) {
         HILOGI("iter bundle %{public}d/%{public}zu, uid=%{public}d, name=%{public}s, priority=%{public}d",
-               count, bundles.size(), bundle.uid_, bundle.name_.c_str(), bundle.priority_);
-        if (bundle.priority_ < minPrio) {
+               count, snapshot->Size(), bundle->uid, bundle->name.c_str(), bundle->priority);
+        if (bundle->priority < minPrio) {
             HILOGD("finish to handle all bundles with priority bigger than %{public}d, break!", minPrio);
             break;
         }
-        if (KernelInterface::GetInstance().GetSystemCurTime() - bundle.GetCreateTime() < NOT_TO_KILL_DURING) {
-            HILOGD("bundle uid<%{public}d> <%{public}s> is protected, skiped.",
-                bundle.uid_, bundle.name_.c_str());
-            count++;
-            continue;
-        }
-        if (bundle.GetState() == BundleState::STATE_WAITING_FOR_KILL) {
+        // the snapshot may be built before the state of bundles killed in this event is set
+        if (bundle->state == BundleState::STATE_WAITING_FOR_KILL || killedUids.count(bundle->uid) != 0) {
             HILOGD("bundle uid<%{public}d> <%{public}s> is waiting to kill, skiped.",
-                bundle.uid_, bundle.name_.c_str());
+                bundle->uid, bundle->name.c_str());
             count++;
             continue;
         }
+        // only the most killable bundle is the candidate of one kill
+        if (KernelInterface::GetInstance().GetSystemCurTime() - bundle->createTime < NOT_TO_KILL_DURING) {
+            HILOGD("bundle uid<%{public}d> <%{public}s> is protected, skiped.",
+                bundle->uid, bundle->name.c_str());
+            break;
+        }
 
-        for (auto itrProcess = bundle.procs_.begin(); itrProcess != bundle.procs_.end(); itrProcess++) {
+        for (pid_t pid : bundle->pids) {
             HILOGI("killing pid<%{public}d> with uid<%{public}d> of bundle<%{public}s>",
-                itrProcess->first, bundle.uid_, bundle.name_.c_str());
-            freedBuf += KernelInterface::GetInstance().KillOneProcessByPid(itrProcess->first);
+                pid, bundle->uid, bundle->name.c_str());
+            freedBuf += KillOneProcess(pid);
+            killedPids.push_back(pid);
         }
+        killedUids.insert(bundle->uid);
 
-        ReclaimPriorityManager::GetInstance().SetBundleState(bundle.accountId_, bundle.uid_,
+        ReclaimPriorityManager::GetInstance().SetBundleState(bundle->accountId, bundle->uid,
                                                              BundleState::STATE_WAITING_FOR_KILL);
-        if (freedBuf) {
-            HILOGD("freedBuf = %{public}d, break iter", freedBuf);
-            break;
-        }
-        count++;
+        HILOGD("freedBuf = %{public}d, break iter", freedBuf);
+        break;
     }
     HILOGD("iter bundles end");
     return freedBuf;
@@ -170,14 +195,16 @@ std::pair<unsigned int, int> LowMemoryKiller::QueryKillMemoryPriorityPair(unsign
 }
 
 /* Low memory killer core function */
-void LowMemoryKiller::PsiHandlerInner()
+void LowMemoryKiller::PsiHandlerInner(int level)
 {
-    HILOGD("[%{public}ld] called", ++calledCount_);
+    HILOGD("[%{public}ld] called, psi level=%{public}d", ++calledCount_, level);
     int freedBuf = 0;
     unsigned int targetBuf = 0;
     unsigned int targetKillKb = 0;
     unsigned int currKillKb = 0;
     int killCnt = 0;
+    int maxKillCnt = MAX_KILL_CNT_PER_EVENT + (level > 0 ? level : 0) * KILL_CNT_STEP_PER_PSI_LEVEL;
+    std::unordered_set<int> killedUids;
 
     unsigned int curBuf = static_cast<unsigned int>(KernelInterface::GetInstance().GetCurrentBuffer());
     HILOGE("[%{public}ld] current buffer = %{public}u KB", calledCount_, curBuf);
@@ -203,7 +230,8 @@ void LowMemoryKiller::PsiHandlerInner()
     do {
         /* print process mem info in dmesg, 1 means it is limited by print interval. Ignore return val   */
         KernelInterface::GetInstance().EchoToPath(LMKD_DBG_TRIGGER_FILE_PATH.c_str(), "1");
-        if ((freedBuf = KillOneBundleByPrio(minPrio)) <= 0) {
+        std::vector<pid_t> killedPids;
+        if ((freedBuf = KillOneBundleByPrio(minPrio, killedPids, killedUids)) <= 0) {
             HILOGD("[%{public}ld] Noting to kill above score %{public}d!", calledCount_, minPrio);
             goto out;
         }
@@ -211,6 +239,9 @@ void LowMemoryKiller::PsiHandlerInner()
         killCnt++;
         HILOGD("[%{public}ld] killCnt = %{public}d", calledCount_, killCnt);
 
+        // memory of victims is not freed until they exit, wait for it before checking buffer
+        ProcessHandleTable::GetInstance().WaitForExit(killedPids, WAIT_KILLED_PROC_EXIT_MS);
+
         int availBuf = KernelInterface::GetInstance().GetCurrentBuffer();
         if (availBuf < 0 || availBuf >= MAX_BUFFER_KB) {
             HILOGE("[%{public}ld] get buffer failed, go out!", calledCount_);
@@ -220,7 +251,7 @@ void LowMemoryKiller::PsiHandlerInner()
             killLevel_ = 0;
             goto out;
         }
-    } while (currKillKb < targetKillKb && killCnt < MAX_KILL_CNT_PER_EVENT);
+    } while (currKillKb < targetKillKb && killCnt < maxKillCnt);
 
 out:
     if (currKillKb > 0) {
@@ -229,13 +260,13 @@ out:
     }
 }
 
-void LowMemoryKiller::PsiHandler()
+void LowMemoryKiller::PsiHandler(int level)
 {
     if (!initialized_) {
         HILOGE("is not initialized, return!");
         return;
     }
-    handler_->PostImmediateTask([this] { this->PsiHandlerInner(); });
+    PsiEventDispatcher::GetInstance().Dispatch(TAG, level);
 }
 } // namespace Memory
 } // namespace OHOS
\ No newline at end of file
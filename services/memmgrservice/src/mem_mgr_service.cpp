@@ -119,11 +119,10 @@ void MemMgrService::OnStop()
 int32_t MemMgrService::GetBundlePriorityList(BundlePriorityList &bundlePrioList)
 {
     HILOGI("called");
-    ReclaimPriorityManager::BunldeCopySet bundleSet;
-    ReclaimPriorityManager::GetInstance().GetBundlePrioSet(bundleSet);
-    for (auto bundlePriorityInfo : bundleSet) {
-        Memory::BundlePriority bi = Memory::BundlePriority(bundlePriorityInfo.uid_,
-            bundlePriorityInfo.name_, bundlePriorityInfo.priority_, bundlePriorityInfo.accountId_);
+    BundlePrioritySnapshotPtr snapshot = ReclaimPriorityManager::GetInstance().GetBundlePrioSnapshot();
+    for (auto &bundlePriorityInfo : snapshot->GetBundles()) {
+        Memory::BundlePriority bi = Memory::BundlePriority(bundlePriorityInfo->uid,
+            bundlePriorityInfo->name, bundlePriorityInfo->priority, bundlePriorityInfo->accountId);
         bundlePrioList.AddBundleInfo(bi);
     }
     bundlePrioList.SetCount(bundlePrioList.Size());
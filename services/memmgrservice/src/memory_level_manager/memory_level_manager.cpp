@@ -22,6 +22,7 @@
 #include "memmgr_config_manager.h"
 #include "memmgr_log.h"
 #include "memmgr_ptr_util.h"
+#include "psi_event_dispatcher.h"
 #include "reclaim_priority_manager.h"
 #ifdef USE_PURGEABLE_MEMORY
 #include "purgeable_mem_manager.h"
@@ -37,7 +38,8 @@ IMPLEMENT_SINGLE_INSTANCE(MemoryLevelManager);
 
 MemoryLevelManager::MemoryLevelManager()
 {
-    initialized_ = GetEventHandler();
+    initialized_ = GetEventHandler() && PsiEventDispatcher::GetInstance().AddConsumer(TAG, handler_,
+        [this](int level) { this->PsiHandlerInner(level); });
     if (initialized_) {
         HILOGI("init succeeded");
     } else {
@@ -48,8 +50,8 @@ MemoryLevelManager::MemoryLevelManager()
 bool MemoryLevelManager::GetEventHandler()
 {
     if (!handler_) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
-                     AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return false,
+                     ExecutorLane::RECLAIM);
     }
     return true;
 }
@@ -85,11 +87,10 @@ bool MemoryLevelManager::CalcSystemMemoryLevel(SystemMemoryInfo &info)
 
 bool MemoryLevelManager::CalcReclaimAppList(std::vector<std::shared_ptr<AppEntity>> &appList)
 {
-    ReclaimPriorityManager::BunldeCopySet bundleSet;
-    ReclaimPriorityManager::GetInstance().GetBundlePrioSet(bundleSet);
-    for (auto bundleInfo : bundleSet) {
+    BundlePrioritySnapshotPtr snapshot = ReclaimPriorityManager::GetInstance().GetBundlePrioSnapshot();
+    for (auto &bundleInfo : snapshot->GetBundles()) {
         std::shared_ptr<AppEntity> app;
-        MAKE_POINTER(app, shared, AppEntity, "make shared failed", return false, bundleInfo.uid_, bundleInfo.name_);
+        MAKE_POINTER(app, shared, AppEntity, "make shared failed", return false, bundleInfo->uid, bundleInfo->name);
         appList.push_back(app);
         HILOGI("The app will be reclaimed, uid:%{public}d, name:%{public}s.", app->uid_, app->name_.c_str());
     }
@@ -161,25 +162,25 @@ void MemoryLevelManager::TriggerMemoryLevelByDump(SystemMemoryInfo &info)
     NotifyMemoryLevel(info);
 }
 
-void MemoryLevelManager::PsiHandlerInner()
+void MemoryLevelManager::PsiHandlerInner(int level)
 {
-    HILOGD("[%{public}ld] called", ++calledCount_);
+    HILOGD("[%{public}ld] called, psi level=%{public}d", ++calledCount_, level);
 
     /* Calculate the system memory level */
-    SystemMemoryInfo info = {MemorySource::PSI_MEMORY, SystemMemoryLevel::UNKNOWN};
+    SystemMemoryInfo info = {MemorySource::PSI_MEMORY, SystemMemoryLevel::UNKNOWN, level};
     if (!CalcSystemMemoryLevel(info)) {
         return;
     }
     NotifyMemoryLevel(info);
 }
 
-void MemoryLevelManager::PsiHandler()
+void MemoryLevelManager::PsiHandler(int level)
 {
     if (!initialized_) {
         HILOGE("is not initialized, return!");
         return;
     }
-    handler_->PostImmediateTask([this] { this->PsiHandlerInner(); });
+    PsiEventDispatcher::GetInstance().Dispatch(TAG, level);
 }
 } // namespace Memory
 } // namespace OHOS
@@ -199,8 +199,8 @@ bool NandLifeController::GetAndValidateNandLifeConfig()
 bool NandLifeController::GetEventHandler()
 {
     if (handler_ == nullptr) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
-            AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return false,
+            ExecutorLane::TIMER);
     }
     return true;
 }
@@ -57,8 +57,8 @@ bool PurgeableMemManager::GetEventHandler()
     }
 #endif
     if (!handler_) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
-            AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return false,
+            ExecutorLane::RECLAIM);
     }
     return true;
 }
@@ -579,11 +579,14 @@ void PurgeableMemManager::TriggerByPsi(const SystemMemoryInfo &info)
 {
     HILOGD("called");
     time_t now = time(0);
-    if (lastTriggerTime_ != 0 && (now - lastTriggerTime_) < TRIGGER_INTERVAL_SECOND) {
+    // pressure escalated to a more urgent psi level, do not wait for the interval
+    bool escalated = info.psiLevel > lastTriggerPsiLevel_;
+    if (!escalated && lastTriggerTime_ != 0 && (now - lastTriggerTime_) < TRIGGER_INTERVAL_SECOND) {
         HILOGD("Less than %{public}u s from last trigger, no action is required.", TRIGGER_INTERVAL_SECOND);
         return;
     } else {
         lastTriggerTime_ = now;
+        lastTriggerPsiLevel_ = info.psiLevel;
     }
 
     unsigned int currentBuffer = static_cast<unsigned int>(KernelInterface::GetInstance().GetCurrentBuffer());
@@ -726,4 +729,4 @@ bool PurgeableMemManager::IsPurgeWhiteApp(const std::string &curAppName)
     return false;
 }
 } // namespace Memory
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_name_table.h"
+
+#include <new>
+
+#include "memmgr_log.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "BundleNameTable";
+const std::string EMPTY_NAME = "";
+}
+
+IMPLEMENT_SINGLE_INSTANCE(BundleNameTable);
+
+BundleNameTable::BundleNameTable()
+{
+    for (auto &chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    Intern(EMPTY_NAME); // take EMPTY_ID
+}
+
+BundleNameTable::~BundleNameTable()
+{
+    for (auto &chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+BundleNameTable::Id BundleNameTable::Intern(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    uint32_t id = count_.load(std::memory_order_relaxed);
+    uint32_t chunkIndex = id >> CHUNK_BITS;
+    if (chunkIndex >= MAX_CHUNKS) {
+        HILOGE("too many names, %{public}s is not interned", name.c_str());
+        return EMPTY_ID;
+    }
+    std::string *chunk = chunks_[chunkIndex].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new (std::nothrow) std::string[CHUNK_SIZE];
+        if (chunk == nullptr) {
+            HILOGE("new chunk failed, %{public}s is not interned", name.c_str());
+            return EMPTY_ID;
+        }
+        chunks_[chunkIndex].store(chunk, std::memory_order_release);
+    }
+    chunk[id & (CHUNK_SIZE - 1)] = name;
+    ids_.emplace(name, id);
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+bool BundleNameTable::Find(const std::string &name, Id &id)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = ids_.find(name);
+    if (it == ids_.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+const std::string &BundleNameTable::GetName(Id id) const
+{
+    if (id >= count_.load(std::memory_order_acquire)) {
+        return EMPTY_NAME;
+    }
+    return chunks_[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+}
+
+size_t BundleNameTable::Size() const
+{
+    return count_.load(std::memory_order_relaxed);
+}
+} // namespace Memory
+} // namespace OHOS
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_priority_index.h"
+
+namespace OHOS {
+namespace Memory {
+BundlePriorityIndex::Iterator& BundlePriorityIndex::Iterator::operator++()
+{
+    if (node_ != nullptr) {
+        node_ = (node_->next != nullptr) ? node_->next : index_->FirstNodeFrom(node_->bucket + 1);
+    }
+    return *this;
+}
+
+BundlePriorityIndex::Iterator BundlePriorityIndex::Iterator::operator++(int)
+{
+    Iterator tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+BundlePriorityIndex::Iterator& BundlePriorityIndex::Iterator::operator--()
+{
+    if (node_ == nullptr) {
+        node_ = index_->LastNodeUpTo(BUCKET_COUNT - 1);
+    } else {
+        node_ = (node_->prev != nullptr) ? node_->prev : index_->LastNodeUpTo(node_->bucket - 1);
+    }
+    return *this;
+}
+
+BundlePriorityIndex::Iterator BundlePriorityIndex::Iterator::operator--(int)
+{
+    Iterator tmp = *this;
+    --(*this);
+    return tmp;
+}
+
+int BundlePriorityIndex::PriorityToBucket(int priority)
+{
+    if (priority < RECLAIM_PRIORITY_MIN) {
+        priority = RECLAIM_PRIORITY_MIN;
+    } else if (priority > RECLAIM_PRIORITY_MAX) {
+        priority = RECLAIM_PRIORITY_MAX;
+    }
+    return priority - RECLAIM_PRIORITY_MIN;
+}
+
+void BundlePriorityIndex::Link(Node *node, int bucket)
+{
+    Bucket &target = buckets_[bucket];
+    node->bucket = bucket;
+    node->prev = nullptr;
+    node->next = target.head;
+    if (target.head != nullptr) {
+        target.head->prev = node;
+    } else {
+        target.tail = node;
+        nonEmptyBitmap_[bucket / BITS_PER_WORD] |= (1ULL << (bucket % BITS_PER_WORD));
+    }
+    target.head = node;
+}
+
+void BundlePriorityIndex::Unlink(Node *node)
+{
+    Bucket &target = buckets_[node->bucket];
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        target.head = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    } else {
+        target.tail = node->prev;
+    }
+    if (target.head == nullptr) {
+        nonEmptyBitmap_[node->bucket / BITS_PER_WORD] &= ~(1ULL << (node->bucket % BITS_PER_WORD));
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+    node->bucket = -1;
+}
+
+BundlePriorityIndex::Node* BundlePriorityIndex::FirstNodeFrom(int bucket) const
+{
+    if (bucket < 0) {
+        bucket = 0;
+    }
+    if (bucket >= BUCKET_COUNT) {
+        return nullptr;
+    }
+    int word = bucket / BITS_PER_WORD;
+    uint64_t bits = nonEmptyBitmap_[word] & (~0ULL << (bucket % BITS_PER_WORD));
+    while (bits == 0) {
+        if (++word >= BITMAP_WORDS) {
+            return nullptr;
+        }
+        bits = nonEmptyBitmap_[word];
+    }
+    return buckets_[word * BITS_PER_WORD + __builtin_ctzll(bits)].head;
+}
+
+BundlePriorityIndex::Node* BundlePriorityIndex::LastNodeUpTo(int bucket) const
+{
+    if (bucket < 0) {
+        return nullptr;
+    }
+    if (bucket >= BUCKET_COUNT) {
+        bucket = BUCKET_COUNT - 1;
+    }
+    int word = bucket / BITS_PER_WORD;
+    int shift = BITS_PER_WORD - 1 - (bucket % BITS_PER_WORD);
+    uint64_t bits = nonEmptyBitmap_[word] & (~0ULL >> shift);
+    while (bits == 0) {
+        if (--word < 0) {
+            return nullptr;
+        }
+        bits = nonEmptyBitmap_[word];
+    }
+    return buckets_[word * BITS_PER_WORD + (BITS_PER_WORD - 1 - __builtin_clzll(bits))].tail;
+}
+
+std::pair<BundlePriorityIndex::Iterator, bool> BundlePriorityIndex::insert(
+    const std::shared_ptr<BundlePriorityInfo> &bundle)
+{
+    if (bundle == nullptr) {
+        return std::make_pair(end(), false);
+    }
+    auto ret = nodes_.emplace(bundle->uid_, Node());
+    Node *node = &ret.first->second;
+    if (!ret.second) {
+        return std::make_pair(Iterator(this, node), false);
+    }
+    node->bundle = bundle;
+    Link(node, PriorityToBucket(bundle->priority_));
+    return std::make_pair(Iterator(this, node), true);
+}
+
+size_t BundlePriorityIndex::erase(const std::shared_ptr<BundlePriorityInfo> &bundle)
+{
+    if (bundle == nullptr) {
+        return 0;
+    }
+    auto it = nodes_.find(bundle->uid_);
+    if (it == nodes_.end()) {
+        return 0;
+    }
+    Unlink(&it->second);
+    nodes_.erase(it);
+    return 1;
+}
+
+BundlePriorityIndex::Iterator BundlePriorityIndex::erase(Iterator pos)
+{
+    if (pos.node_ == nullptr) {
+        return end();
+    }
+    Iterator next = pos;
+    ++next;
+    int uid = pos.node_->bundle->uid_;
+    Unlink(pos.node_);
+    nodes_.erase(uid);
+    return next;
+}
+
+bool BundlePriorityIndex::Update(const std::shared_ptr<BundlePriorityInfo> &bundle)
+{
+    if (bundle == nullptr) {
+        return false;
+    }
+    auto it = nodes_.find(bundle->uid_);
+    if (it == nodes_.end()) {
+        return false;
+    }
+    Node *node = &it->second;
+    int bucket = PriorityToBucket(bundle->priority_);
+    if (node->bucket != bucket) {
+        Unlink(node);
+        Link(node, bucket);
+    }
+    return true;
+}
+
+bool BundlePriorityIndex::Contains(int uid) const
+{
+    return nodes_.find(uid) != nodes_.end();
+}
+
+void BundlePriorityIndex::clear()
+{
+    for (auto &bucket : buckets_) {
+        bucket.head = nullptr;
+        bucket.tail = nullptr;
+    }
+    for (auto &word : nonEmptyBitmap_) {
+        word = 0;
+    }
+    nodes_.clear();
+}
+
+size_t BundlePriorityIndex::size() const
+{
+    return nodes_.size();
+}
+
+bool BundlePriorityIndex::empty() const
+{
+    return nodes_.empty();
+}
+
+BundlePriorityIndex::Iterator BundlePriorityIndex::begin() const
+{
+    return Iterator(this, FirstNodeFrom(0));
+}
+
+BundlePriorityIndex::Iterator BundlePriorityIndex::end() const
+{
+    return Iterator(this, nullptr);
+}
+
+BundlePriorityIndex::reverse_iterator BundlePriorityIndex::rbegin() const
+{
+    return reverse_iterator(end());
+}
+
+BundlePriorityIndex::reverse_iterator BundlePriorityIndex::rend() const
+{
+    return reverse_iterator(begin());
+}
+} // namespace Memory
+} // namespace OHOS
@@ -45,6 +45,12 @@ BundlePriorityInfo::BundlePriorityInfo(const std::string &name, int bundleUid, i
     this->createTime_ = KernelInterface::GetInstance().GetSystemCurTime();
 }
 
+BundlePriorityInfo::BundlePriorityInfo(const BundleName &name, int bundleUid, int priority, int accountId,
+    BundleState state) : name_(name), uid_(bundleUid), priority_(priority), accountId_(accountId), state_(state)
+{
+    this->createTime_ = KernelInterface::GetInstance().GetSystemCurTime();
+}
+
 BundlePriorityInfo::BundlePriorityInfo(const BundlePriorityInfo &copyBundle) : name_(copyBundle.name_),
     uid_(copyBundle.uid_), priority_(copyBundle.priority_), accountId_(copyBundle.accountId_),
     state_(copyBundle.state_), createTime_(copyBundle.createTime_)
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_priority_snapshot.h"
+
+#include <utility>
+
+namespace OHOS {
+namespace Memory {
+BundlePrioritySnapshot::BundlePrioritySnapshot(uint64_t version, EntryList &&bundles)
+    : version_(version), bundles_(std::move(bundles))
+{
+}
+
+uint64_t BundlePrioritySnapshot::GetVersion() const
+{
+    return version_;
+}
+
+const BundlePrioritySnapshot::EntryList& BundlePrioritySnapshot::GetBundles() const
+{
+    return bundles_;
+}
+
+size_t BundlePrioritySnapshot::Size() const
+{
+    return bundles_.size();
+}
+
+bool BundlePrioritySnapshotBuilder::IsEntryOutdated(const BundleSnapshotEntry &entry, BundlePriorityInfo &bundle)
+{
+    if (entry.priority != bundle.priority_ || entry.state != bundle.GetState() ||
+        entry.accountId != bundle.accountId_ || entry.createTime != bundle.GetCreateTime() ||
+        entry.pids.size() != bundle.procs_.size()) {
+        return true;
+    }
+    // both are sorted by pid
+    size_t i = 0;
+    for (auto &pair : bundle.procs_) {
+        if (entry.pids[i++] != pair.first) {
+            return true;
+        }
+    }
+    return false;
+}
+
+BundlePrioritySnapshot::EntryPtr BundlePrioritySnapshotBuilder::MakeEntry(BundlePriorityInfo &bundle)
+{
+    auto entry = std::make_shared<BundleSnapshotEntry>();
+    entry->uid = bundle.uid_;
+    entry->accountId = bundle.accountId_;
+    entry->priority = bundle.priority_;
+    entry->state = bundle.GetState();
+    entry->createTime = bundle.GetCreateTime();
+    entry->name = bundle.name_;
+    entry->pids.reserve(bundle.procs_.size());
+    for (auto &pair : bundle.procs_) {
+        entry->pids.push_back(pair.first);
+    }
+    return entry;
+}
+
+BundlePrioritySnapshotPtr BundlePrioritySnapshotBuilder::Build(const BundlePriorityIndex &index)
+{
+    BundlePrioritySnapshot::EntryList bundles;
+    bundles.reserve(index.size());
+    std::unordered_map<int, BundlePrioritySnapshot::EntryPtr> entries;
+    entries.reserve(index.size());
+    for (auto itrBundle = index.rbegin(); itrBundle != index.rend(); ++itrBundle) {
+        const std::shared_ptr<BundlePriorityInfo> &bundle = *itrBundle;
+        if (bundle == nullptr) {
+            continue;
+        }
+        BundlePrioritySnapshot::EntryPtr entry;
+        auto last = lastEntries_.find(bundle->uid_);
+        if (last != lastEntries_.end() && last->second->name == bundle->name_ &&
+            !IsEntryOutdated(*last->second, *bundle)) {
+            entry = last->second;
+        } else {
+            entry = MakeEntry(*bundle);
+        }
+        bundles.push_back(entry);
+        entries.emplace(bundle->uid_, std::move(entry));
+    }
+    lastEntries_.swap(entries);
+    return std::make_shared<const BundlePrioritySnapshot>(++version_, std::move(bundles));
+}
+
+void BundlePrioritySnapshotBuilder::Reset()
+{
+    lastEntries_.clear();
+}
+} // namespace Memory
+} // namespace OHOS
@@ -17,7 +17,7 @@
 #include "memmgr_ptr_util.h"
 #include "default_multi_account_strategy.h"
 #include "reclaim_strategy_manager.h"
-#include "kernel_interface.h"
+#include "low_memory_killer.h"
 #include "oom_score_adj_utils.h"
 #include "reclaim_priority_constants.h"
 #include "multi_account_manager.h"
@@ -35,8 +35,8 @@ IMPLEMENT_SINGLE_INSTANCE(MultiAccountManager);
 MultiAccountManager::MultiAccountManager()
 {
     MAKE_POINTER(strategy_, shared, DefaultMultiAccountStrategy, "make shared failed", return, /* no param */);
-    MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return,
-        AppExecFwk::EventRunner::Create());
+    MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return,
+        ExecutorLane::BOOKKEEPING);
 }
 
 MultiAccountManager::~MultiAccountManager()
@@ -231,7 +231,7 @@ void MultiAccountManager::KillProcessesOfAccount(int accountId,
     for (auto iter1 : accountBundleInfo->bundleIdInfoMapping_) {
         for (auto iter2 : iter1.second->procs_) {
             pid_t pid = iter2.first;
-            if (!KernelInterface::GetInstance().KillOneProcessByPid(pid)) {
+            if (!LowMemoryKiller::GetInstance().KillOneProcess(pid)) {
                 HILOGI("Kill the process failed, pid = %{public}d.", pid);
                 continue;
             }
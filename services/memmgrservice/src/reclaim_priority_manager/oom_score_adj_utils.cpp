@@ -13,16 +13,107 @@
  * limitations under the License.
  */
 
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
 #include <string>
-#include <sstream>
-#include "memmgr_log.h"
+#include <unistd.h>
+#include <utility>
 #include "kernel_interface.h"
+#include "memmgr_log.h"
 #include "oom_score_adj_utils.h"
 
 namespace OHOS {
 namespace Memory {
 namespace {
 const std::string TAG = "ReclaimPriorityManager";
+// fds kept open at most, values are still cached for processes beyond it
+const size_t MAX_CACHED_OOM_SCORE_ADJ_FDS = 512;
+const int OOM_SCORE_ADJ_PATH_SIZE = 64;
+}
+
+std::mutex OomScoreAdjUtils::cacheLock_;
+std::unordered_map<pid_t, OomScoreAdjUtils::CacheEntry> OomScoreAdjUtils::cache_;
+size_t OomScoreAdjUtils::cachedFdCount_ = 0;
+
+void OomScoreAdjUtils::CloseEntryLocked(CacheEntry &entry)
+{
+    if (entry.fd >= 0) {
+        close(entry.fd);
+        entry.fd = -1;
+        cachedFdCount_--;
+    }
+}
+
+bool OomScoreAdjUtils::PrepareWriteLocked(pid_t pid, int value, BatchWriteEntry &entry)
+{
+    auto it = cache_.find(pid);
+    if (it != cache_.end() && it->second.written && it->second.value == value) {
+        return false; // nothing changed since last write
+    }
+    char path[OOM_SCORE_ADJ_PATH_SIZE];
+    if (snprintf(path, sizeof(path), "/proc/%d/oom_score_adj", pid) <= 0) {
+        return false;
+    }
+    entry.path = path;
+    entry.content = std::to_string(value);
+    entry.fd = (it != cache_.end()) ? it->second.fd : -1;
+    if (entry.fd < 0 && cachedFdCount_ < MAX_CACHED_OOM_SCORE_ADJ_FDS) {
+        // opened here instead of by KernelInterface, so that it can be kept
+        entry.fd = open(path, O_WRONLY | O_CLOEXEC);
+        if (entry.fd < 0) {
+            HILOGD("open %{public}s failed, errno=%{public}d", path, errno);
+            return false;
+        }
+        it = cache_.emplace(pid, CacheEntry()).first;
+        it->second.fd = entry.fd;
+        cachedFdCount_++;
+    }
+    return true;
+}
+
+void OomScoreAdjUtils::CommitWriteLocked(pid_t pid, int value, const BatchWriteEntry &entry)
+{
+    auto it = cache_.find(pid);
+    if (entry.error != 0) {
+        // the process has died, the cached fd is useless
+        HILOGD("write oom_score_adj of pid=%{public}d failed, errno=%{public}d", pid, entry.error);
+        if (it != cache_.end()) {
+            CloseEntryLocked(it->second);
+            cache_.erase(it);
+        }
+        return;
+    }
+    if (it == cache_.end()) {
+        it = cache_.emplace(pid, CacheEntry()).first;
+    }
+    it->second.value = value;
+    it->second.written = true;
+}
+
+int OomScoreAdjUtils::WriteOomScoreAdjBatch(const std::vector<OomScoreAdjWrite> &writes)
+{
+    std::lock_guard<std::mutex> lock(cacheLock_);
+    std::vector<BatchWriteEntry> entries;
+    std::vector<OomScoreAdjWrite> pending;
+    entries.reserve(writes.size());
+    pending.reserve(writes.size());
+    for (auto &item : writes) {
+        BatchWriteEntry entry;
+        if (PrepareWriteLocked(item.first, item.second, entry)) {
+            entries.push_back(std::move(entry));
+            pending.push_back(item);
+        }
+    }
+    if (entries.empty()) {
+        return 0;
+    }
+    int written = KernelInterface::GetInstance().BatchWrite(entries);
+    for (size_t i = 0; i < entries.size(); i++) {
+        CommitWriteLocked(pending[i].first, pending[i].second, entries[i]);
+    }
+    HILOGD("%{public}d/%{public}zu oom_score_adj written", written, writes.size());
+    return written;
 }
 
 bool OomScoreAdjUtils::WriteOomScoreAdjToKernel(std::shared_ptr<BundlePriorityInfo> bundle)
@@ -31,28 +122,49 @@ bool OomScoreAdjUtils::WriteOomScoreAdjToKernel(std::shared_ptr<BundlePriorityIn
     if (bundle == nullptr) {
         return false;
     }
+    std::vector<OomScoreAdjWrite> writes;
+    writes.reserve(bundle->procs_.size());
     for (auto i = bundle->procs_.begin(); i != bundle->procs_.end(); ++i) {
-        int priority = i->second.priority_;
-        pid_t pid = i->second.pid_;
-        std::stringstream ss;
-        ss << "/proc/" << pid << "/oom_score_adj";
-        std::string path = ss.str();
-        std::string content = std::to_string(priority);
-        HILOGD("prepare to echo %{public}s > %{public}s", content.c_str(), path.c_str());
-        KernelInterface::GetInstance().EchoToPath(path.c_str(), content.c_str());
+        writes.emplace_back(i->second.pid_, i->second.priority_);
     }
+    WriteOomScoreAdjBatch(writes);
     return true;
 }
 
 bool OomScoreAdjUtils::WriteOomScoreAdjToKernel(pid_t pid, int priority)
 {
     HILOGD("called");
-    std::stringstream ss;
-    ss << "/proc/" << pid << "/oom_score_adj";
-    std::string path = ss.str();
-    std::string content = std::to_string(priority);
-    HILOGD("prepare to echo %{public}s > %{public}s", content.c_str(), path.c_str());
-    KernelInterface::GetInstance().EchoToPath(path.c_str(), content.c_str());
+    WriteOomScoreAdjBatch({ OomScoreAdjWrite(pid, priority) });
+    return true;
+}
+
+void OomScoreAdjUtils::ForgetProcess(pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(cacheLock_);
+    auto it = cache_.find(pid);
+    if (it != cache_.end()) {
+        CloseEntryLocked(it->second);
+        cache_.erase(it);
+    }
+}
+
+void OomScoreAdjUtils::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(cacheLock_);
+    for (auto &pair : cache_) {
+        CloseEntryLocked(pair.second);
+    }
+    cache_.clear();
+}
+
+bool OomScoreAdjUtils::GetCachedOomScoreAdj(pid_t pid, int &value)
+{
+    std::lock_guard<std::mutex> lock(cacheLock_);
+    auto it = cache_.find(pid);
+    if (it == cache_.end()) {
+        return false;
+    }
+    value = it->second.value;
     return true;
 }
 } // namespace Memory
@@ -17,14 +17,131 @@
 #include "memmgr_log.h"
 #include "reclaim_priority_constants.h"
 
+#include <algorithm>
+#include <array>
 #include <sstream>
 
 namespace OHOS {
 namespace Memory {
 namespace {
 const std::string TAG = "ProcessPriorityInfo";
+
+// bits of the state flags deciding the priority, used as index of the priority table
+constexpr unsigned int STATUS_FOREGROUND = 1 << 0;
+constexpr unsigned int STATUS_VISIBLE = 1 << 1;
+constexpr unsigned int STATUS_SUSPEND_DELAY = 1 << 2;
+constexpr unsigned int STATUS_BACKGROUND_RUNNING = 1 << 3;
+constexpr unsigned int STATUS_EVENT_START = 1 << 4;
+constexpr unsigned int STATUS_DIST_DEVICE_CONNECTED = 1 << 5;
+constexpr unsigned int STATUS_HAS_UI = 1 << 6;
+constexpr unsigned int STATUS_COUNT = 1 << 7;
+
+int CalculatePriorityByStatus(unsigned int status)
+{
+    if (status & STATUS_FOREGROUND) {
+        return RECLAIM_PRIORITY_FOREGROUND;
+    }
+    if (status & STATUS_VISIBLE) {
+        return RECLAIM_PRIORITY_VISIBLE;
+    }
+    if (status & STATUS_SUSPEND_DELAY) {
+        return RECLAIM_PRIORITY_BG_SUSPEND_DELAY;
+    }
+    if (status & (STATUS_BACKGROUND_RUNNING | STATUS_EVENT_START)) {
+        return RECLAIM_PRIORITY_BG_PERCEIVED;
+    }
+    if (status & STATUS_DIST_DEVICE_CONNECTED) {
+        return RECLAIM_PRIORITY_BG_DIST_DEVICE;
+    }
+    return (status & STATUS_HAS_UI) ? RECLAIM_PRIORITY_BACKGROUND : RECLAIM_PRIORITY_UNKNOWN;
+}
+
+const std::array<int, STATUS_COUNT> &GetStatusPriorityTable()
+{
+    static const std::array<int, STATUS_COUNT> table = [] {
+        std::array<int, STATUS_COUNT> priorities {};
+        for (unsigned int status = 0; status < STATUS_COUNT; status++) {
+            priorities[status] = CalculatePriorityByStatus(status);
+        }
+        return priorities;
+    }();
+    return table;
+}
+
+bool PidLess(const ProcBindMap::value_type &item, int32_t pid)
+{
+    return item.first < pid;
+}
 } // namespace
 
+ProcBindMap::ProcBindMap(const ProcBindMap &other)
+{
+    if (other.items_ != nullptr) {
+        items_ = std::make_unique<std::vector<value_type>>(*other.items_);
+    }
+}
+
+ProcBindMap &ProcBindMap::operator=(const ProcBindMap &other)
+{
+    if (this != &other) {
+        items_ = other.items_ == nullptr ? nullptr : std::make_unique<std::vector<value_type>>(*other.items_);
+    }
+    return *this;
+}
+
+const ProcBindMap::value_type *ProcBindMap::begin() const
+{
+    return items_ == nullptr ? nullptr : items_->data();
+}
+
+const ProcBindMap::value_type *ProcBindMap::end() const
+{
+    return items_ == nullptr ? nullptr : items_->data() + items_->size();
+}
+
+size_t ProcBindMap::size() const
+{
+    return items_ == nullptr ? 0 : items_->size();
+}
+
+bool ProcBindMap::empty() const
+{
+    return size() == 0;
+}
+
+int32_t &ProcBindMap::operator[](int32_t pid)
+{
+    if (items_ == nullptr) {
+        items_ = std::make_unique<std::vector<value_type>>();
+    }
+    auto it = std::lower_bound(items_->begin(), items_->end(), pid, PidLess);
+    if (it == items_->end() || it->first != pid) {
+        it = items_->insert(it, value_type(pid, 0));
+    }
+    return it->second;
+}
+
+size_t ProcBindMap::erase(int32_t pid)
+{
+    if (items_ == nullptr) {
+        return 0;
+    }
+    auto it = std::lower_bound(items_->begin(), items_->end(), pid, PidLess);
+    if (it == items_->end() || it->first != pid) {
+        return 0;
+    }
+    items_->erase(it);
+    if (items_->empty()) {
+        items_.reset();
+    }
+    return 1;
+}
+
+void ProcBindMap::clear()
+{
+    items_.reset();
+}
+
 ProcessPriorityInfo::ProcessPriorityInfo(pid_t pid, int bundleUid, int priority, bool isImportant)
 {
     this->uid_ = bundleUid;
@@ -40,43 +157,19 @@ ProcessPriorityInfo::ProcessPriorityInfo(pid_t pid, int bundleUid, int priority,
     this->isEventStart = false;
     this->isDistDeviceConnected = false;
     this->isExtension_ = false;
+    this->hasUI_ = false;
     this->extensionBindStatus = EXTENSION_STATUS_BIND_UNKOWN;
     this->isAbilityStarting_ = false;
     this->startingAbilityTime_ = INVALID_TIME;
 }
 
-ProcessPriorityInfo::ProcessPriorityInfo(const ProcessPriorityInfo &copyProcess)
-{
-    this->uid_ = copyProcess.uid_;
-    this->pid_ = copyProcess.pid_;
-    this->priority_ = copyProcess.priority_;
-    this->priorityIfImportant_ = copyProcess.priorityIfImportant_;
-    this->isImportant_ = copyProcess.isImportant_;
-    this->isVisible_ = copyProcess.isVisible_;
-    this->isRender_ = copyProcess.isRender_;
-    this->isFreground = copyProcess.isFreground;
-    this->isExtension_ = copyProcess.isExtension_;
-    this->hasUI_ = copyProcess.hasUI_;
-    this->isBackgroundRunning = copyProcess.isBackgroundRunning;
-    this->isSuspendDelay = copyProcess.isSuspendDelay;
-    this->isEventStart = copyProcess.isEventStart;
-    this->isDistDeviceConnected = copyProcess.isDistDeviceConnected;
-    this->extensionBindStatus = copyProcess.extensionBindStatus;
-    for (auto &pair : copyProcess.procsBindToMe_) {
-        this->procsBindToMe_.insert(std::make_pair(pair.first, pair.second));
-    }
-    for (auto &pair : copyProcess.procsBindFromMe_) {
-        this->procsBindFromMe_.insert(std::make_pair(pair.first, pair.second));
-    }
-
-    this->isAbilityStarting_ = copyProcess.isAbilityStarting_;
-    this->startingAbilityTime_ = copyProcess.startingAbilityTime_;
-}
-
-ProcessPriorityInfo::~ProcessPriorityInfo()
+int ProcessPriorityInfo::GetPriorityByStatus() const
 {
-    procsBindToMe_.clear();
-    procsBindFromMe_.clear();
+    unsigned int status = (isFreground ? STATUS_FOREGROUND : 0) | (isVisible_ ? STATUS_VISIBLE : 0) |
+        (isSuspendDelay ? STATUS_SUSPEND_DELAY : 0) | (isBackgroundRunning ? STATUS_BACKGROUND_RUNNING : 0) |
+        (isEventStart ? STATUS_EVENT_START : 0) | (isDistDeviceConnected ? STATUS_DIST_DEVICE_CONNECTED : 0) |
+        (hasUI_ ? STATUS_HAS_UI : 0);
+    return GetStatusPriorityTable()[status];
 }
 
 void ProcessPriorityInfo::SetPriority(int targetPriority)
@@ -15,14 +15,19 @@
 
 #include "reclaim_priority_manager.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "app_mgr_interface.h"
 #include "bundle_mgr_proxy.h"
 #include "iservice_registry.h"
 #include "kernel_interface.h"
+#include "low_memory_killer.h"
 #include "memmgr_log.h"
 #include "memmgr_ptr_util.h"
 #include "multi_account_manager.h"
 #include "oom_score_adj_utils.h"
+#include "process_handle_table.h"
 #include "reclaim_priority_constants.h"
 #include "reclaim_strategy_manager.h"
 #include "render_process_info.h"
@@ -36,16 +41,31 @@ const std::string TAG = "ReclaimPriorityManager";
 constexpr int TIMER_DIED_PROC_FAST_CHECK_MS = 10000;
 constexpr int TIMER_DIED_PROC_SLOW_CHECK_MS = 3 * 60 * 1000; // 3min
 constexpr int MAX_TOTALBUNDLESET_SIZE = 2000;
+// when exits of all processes are watched by pidfds, the /proc sweep is only a rare consistency check
+constexpr unsigned int DIED_PROC_SWEEP_PERIOD = 10;
 
 constexpr int TIMER_ABILITY_START_CHECK_MS = 10 * 1000; // 10s
 constexpr int TIMER_DELAY_MS = 15 * 1000; // 15s
+// an extension is less important than its most important connector by this delta
+constexpr int EXTENSION_PRIORITY_DELTA = 100;
+constexpr int MAX_EXTENSION_PROPAGATION_VISITS = 8;
+// all delayed checks are coarse, the shortest one is 10s
+constexpr int64_t TIMER_WHEEL_TICK_MS = 500;
+const std::string TIMER_WHEEL_TASK = "ReclaimPriorityTimerWheel";
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 }
 IMPLEMENT_SINGLE_INSTANCE(ReclaimPriorityManager);
 
-ReclaimPriorityManager::ReclaimPriorityManager()
+ReclaimPriorityManager::ReclaimPriorityManager() : timerWheel_(TIMER_WHEEL_TICK_MS, GetSteadyTimeMs())
 {
     InitUpdateReasonStrMapping();
     InitChangeProcMapping();
+    bundlePrioSnapshot_ = bundlePrioSnapshotBuilder_.Build(totalBundlePrioSet_);
 }
 
 void ReclaimPriorityManager::InitUpdateReasonStrMapping()
@@ -91,8 +111,16 @@ std::string& ReclaimPriorityManager::AppStateUpdateResonToString(AppStateUpdateR
 bool ReclaimPriorityManager::Init()
 {
     config_ = MemmgrConfigManager::GetInstance().GetReclaimPriorityConfig();
+    InternImportantProcs();
+    updateCoalesceWindowMs_ = config_.GetUpdateCoalesceWindowMs();
     initialized_ = GetEventHandler();
     GetAllKillableSystemApps();
+    ProcessHandleTable::GetInstance().SetExitCallback([this](pid_t pid, int uid) {
+        if (handler_ != nullptr) {
+            handler_->PostTask([this, pid, uid] { this->HandleProcessExit(pid, uid); }, 0,
+                AppExecFwk::EventQueue::Priority::HIGH);
+        }
+    });
     if (initialized_) {
         HILOGI("init successed");
     } else {
@@ -105,8 +133,8 @@ bool ReclaimPriorityManager::Init()
 bool ReclaimPriorityManager::GetEventHandler()
 {
     if (!handler_) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
-            AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return false,
+            ExecutorLane::BOOKKEEPING);
     }
     return true;
 }
@@ -149,6 +177,20 @@ void ReclaimPriorityManager::Dump(int fd)
         }
     }
     dprintf(fd, "-----------------------------------------------------------------\n");
+    dprintf(fd, "update coalesce window: %ums, %llu updates applied to %llu processes\n", updateCoalesceWindowMs_,
+        static_cast<unsigned long long>(coalescedUpdateCount_), static_cast<unsigned long long>(coalescedApplyCount_));
+    dprintf(fd, "timer wheel: %zu timers, %llu fired\n", timerWheel_.Size(),
+        static_cast<unsigned long long>(timerWheelFiredCount_));
+    {
+        std::lock_guard<std::mutex> lock(keepAliveCacheLock_);
+        dprintf(fd, "keepAlive cache: %zu uids, %llu hits, %llu answers from BundleMgr\n", keepAliveCache_.size(),
+            static_cast<unsigned long long>(keepAliveCacheHits_), static_cast<unsigned long long>(keepAliveQueries_));
+    }
+    {
+        std::lock_guard<std::mutex> lock(foregroundAppsLock_);
+        dprintf(fd, "foreground apps: %zu, synced with AppMgr: %d\n", foregroundApps_.size(), foregroundAppsSynced_);
+    }
+    ProcessHandleTable::GetInstance().Dump(fd);
 }
 
 sptr<AppExecFwk::IAppMgr> GetAppMgrProxy()
@@ -158,7 +200,49 @@ sptr<AppExecFwk::IAppMgr> GetAppMgrProxy()
     return iface_cast<AppExecFwk::IAppMgr>(appObject);
 }
 
-bool ReclaimPriorityManager::IsFrontApp(const std::string& pkgName, int32_t uid, int32_t pid)
+namespace {
+inline uint64_t ForegroundAppKey(int32_t uid, BundleNameTable::Id nameId)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(uid)) << 32) | nameId; // 32: bits of name id
+}
+}
+
+void ReclaimPriorityManager::UpdateForegroundApps()
+{
+    uint64_t startVersion = 0;
+    {
+        std::lock_guard<std::mutex> lock(foregroundAppsLock_);
+        startVersion = foregroundAppsVersion_;
+        foregroundAppsSyncing_++;
+    }
+    std::unordered_set<uint64_t> foregroundApps;
+    bool fetched = FetchForegroundApps(foregroundApps);
+
+    std::lock_guard<std::mutex> lock(foregroundAppsLock_);
+    if (fetched) {
+        // callbacks during the fetch may be missing from the list
+        for (const auto &change : foregroundAppChanges_) {
+            if (change.version <= startVersion) {
+                continue;
+            }
+            if (change.isForeground) {
+                foregroundApps.insert(change.key);
+            } else {
+                foregroundApps.erase(change.key);
+            }
+        }
+        HILOGI("foreground apps synced with AppMgr, %{public}zu before, %{public}zu now, "
+            "%{public}llu changes during sync", foregroundApps_.size(), foregroundApps.size(),
+            static_cast<unsigned long long>(foregroundAppsVersion_ - startVersion));
+        foregroundApps_.swap(foregroundApps);
+        foregroundAppsSynced_ = true;
+    }
+    if (--foregroundAppsSyncing_ == 0) {
+        foregroundAppChanges_.clear();
+    }
+}
+
+bool ReclaimPriorityManager::FetchForegroundApps(std::unordered_set<uint64_t> &foregroundApps)
 {
     sptr<AppExecFwk::IAppMgr> appMgrProxy_ = GetAppMgrProxy();
     if (!appMgrProxy_) {
@@ -170,12 +254,45 @@ bool ReclaimPriorityManager::IsFrontApp(const std::string& pkgName, int32_t uid,
         HILOGE("GetForegroundApplications failed");
         return false;
     }
-    for (auto fgApp : fgAppList) {
-        if (fgApp.bundleName == pkgName && fgApp.uid == uid) {
-            return true;
-        }
+    for (const auto &fgApp : fgAppList) {
+        foregroundApps.insert(ForegroundAppKey(fgApp.uid, BundleNameTable::GetInstance().Intern(fgApp.bundleName)));
     }
-    return false;
+    return true;
+}
+
+void ReclaimPriorityManager::NotifyForegroundAppChanged(int32_t uid, const std::string &bundleName,
+    bool isForeground)
+{
+    uint64_t key = ForegroundAppKey(uid, BundleNameTable::GetInstance().Intern(bundleName));
+    std::lock_guard<std::mutex> lock(foregroundAppsLock_);
+    foregroundAppsVersion_++;
+    if (foregroundAppsSyncing_ > 0) {
+        foregroundAppChanges_.push_back({ foregroundAppsVersion_, key, isForeground });
+    }
+    if (isForeground) {
+        foregroundApps_.insert(key);
+    } else {
+        foregroundApps_.erase(key);
+    }
+}
+
+bool ReclaimPriorityManager::IsFrontApp(const std::string& pkgName, int32_t uid, int32_t pid)
+{
+    bool synced = false;
+    {
+        std::lock_guard<std::mutex> lock(foregroundAppsLock_);
+        synced = foregroundAppsSynced_;
+    }
+    if (!synced) {
+        // only if AppMgr was not ready at startup or has not come back yet
+        UpdateForegroundApps();
+    }
+    BundleNameTable::Id nameId = BundleNameTable::EMPTY_ID;
+    if (!BundleNameTable::GetInstance().Find(pkgName, nameId)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(foregroundAppsLock_);
+    return foregroundApps_.count(ForegroundAppKey(uid, nameId)) > 0;
 }
 
 void ReclaimPriorityManager::GetAllKillableSystemApps()
@@ -187,6 +304,33 @@ void ReclaimPriorityManager::GetAllKillableSystemApps()
     std::set<std::string> killableSystemAppsFromAms_;
     GetKillableSystemAppsFromAms(killableSystemAppsFromAms_);
     allKillableSystemApps_.merge(killableSystemAppsFromAms_);
+    InternKillableSystemApps();
+}
+
+void ReclaimPriorityManager::InternKillableSystemApps()
+{
+    for (const std::string &name : allKillableSystemApps_) {
+        killableSystemAppIds_.insert(BundleNameTable::GetInstance().Intern(name));
+    }
+}
+
+void ReclaimPriorityManager::NotifyPackageChanged(int uid)
+{
+    std::lock_guard<std::mutex> lock(keepAliveCacheLock_);
+    if (uid < 0) {
+        keepAliveCache_.clear();
+    } else {
+        keepAliveCache_.erase(uid);
+    }
+    HILOGD("package of uid=%{public}d changed", uid);
+}
+
+void ReclaimPriorityManager::InternImportantProcs()
+{
+    importantProcIds_.clear();
+    for (const auto &pair : config_.GetImportantBgApps()) {
+        importantProcIds_[BundleNameTable::GetInstance().Intern(pair.first)] = pair.second;
+    }
 }
 
 void ReclaimPriorityManager::GetKillableSystemAppsFromAms(std::set<std::string> &killableApps)
@@ -199,31 +343,30 @@ void ReclaimPriorityManager::GetKillableSystemAppsFromAms(std::set<std::string>
 void ReclaimPriorityManager::NotifyKillableSystemAppsAdded(std::set<std::string> &newKillableApps)
 {
     allKillableSystemApps_.merge(newKillableApps);
+    InternKillableSystemApps();
 }
 
 // handle process started before our service
 void ReclaimPriorityManager::HandlePreStartedProcs()
 {
-    std::vector<unsigned int> preStartedPids;
-    KernelInterface::GetInstance().GetAllProcPids(preStartedPids);
-    for (unsigned int pid : preStartedPids) {
-        unsigned int uid = 0;
-        if (!KernelInterface::GetInstance().GetUidByPid(pid, uid)) {
-            HILOGE("process[pid=%{public}d] started before me, but GetUidByPid failed.", pid);
-            continue;
-        }
-        struct ProcInfo procInfo;
-        std::string name;
-        if (!KernelInterface::GetInstance().GetProcNameByPid(pid, name)) {
-            HILOGE("process[pid=%{public}d, uid=%{public}d] started before me, but GetProcNameByPid failed.", pid, uid);
-            continue;
-        }
-        if (allKillableSystemApps_.find(name) != allKillableSystemApps_.end()) {
-            OomScoreAdjUtils::WriteOomScoreAdjToKernel(pid, RECLAIM_PRIORITY_KILLABLE_SYSTEM);
+    std::vector<ProcStatus> preStartedProcs;
+    if (!KernelInterface::GetInstance().GetAllProcStatus(preStartedProcs)) {
+        HILOGE("get status of processes started before me failed.");
+        return;
+    }
+    std::vector<OomScoreAdjUtils::OomScoreAdjWrite> writes;
+    for (const ProcStatus &proc : preStartedProcs) {
+        if (allKillableSystemApps_.find(proc.name) != allKillableSystemApps_.end()) {
+            writes.emplace_back(proc.pid, RECLAIM_PRIORITY_KILLABLE_SYSTEM);
             HILOGI("process[pid=%{public}d, uid=%{public}d, name=%{public}s] started before me, killable = %{public}d",
-                pid, uid, name.c_str(), true);
+                proc.pid, proc.uid, proc.name.c_str(), true);
         }
     }
+    OomScoreAdjUtils::WriteOomScoreAdjBatch(writes);
+    // these processes are not managed, nothing would forget their cache when they die
+    for (const auto &write : writes) {
+        OomScoreAdjUtils::ForgetProcess(write.first);
+    }
 }
 
 void ReclaimPriorityManager::GetBundlePrioSet(BunldeCopySet &bundleSet)
@@ -294,13 +437,34 @@ void ReclaimPriorityManager::GetOneKillableBundle(int minPrio, BunldeCopySet &bu
             for (auto procEntry : bundle->procs_) {
                 HILOGE("quick killing bundle<%{public}d, %{public}s}>, pid=%{public}d", bundle->uid_,
                     bundle->name_.c_str(), procEntry.second.pid_);
-                KernelInterface::GetInstance().KillOneProcessByPid(procEntry.second.pid_);
+                LowMemoryKiller::GetInstance().KillOneProcess(procEntry.second.pid_);
             }
         }
     }
     HILOGD("iter bundles end");
 }
 
+BundlePrioritySnapshotPtr ReclaimPriorityManager::GetBundlePrioSnapshot()
+{
+    // a writer holding the set is never waited, the last snapshot built is used instead
+    if (bundlePrioSnapshotDirty_.load(std::memory_order_acquire) && totalBundlePrioSetLock_.try_lock()) {
+        if (bundlePrioSnapshotDirty_.exchange(false, std::memory_order_acq_rel)) {
+            BundlePrioritySnapshotPtr snapshot = bundlePrioSnapshotBuilder_.Build(totalBundlePrioSet_);
+            HILOGD("publish snapshot version=%{public}llu, %{public}zu bundles",
+                static_cast<unsigned long long>(snapshot->GetVersion()), snapshot->Size());
+            std::atomic_store(&bundlePrioSnapshot_, snapshot);
+        }
+        totalBundlePrioSetLock_.unlock();
+    }
+    return std::atomic_load(&bundlePrioSnapshot_);
+}
+
+// call it with totalBundlePrioSetLock_ held, after a batch of changes to bundles
+void ReclaimPriorityManager::MarkBundlePrioSnapshotDirty()
+{
+    bundlePrioSnapshotDirty_.store(true, std::memory_order_release);
+}
+
 void ReclaimPriorityManager::SetBundleState(int accountId, int uid, BundleState state)
 {
     std::lock_guard<std::mutex> setLock(totalBundlePrioSetLock_);
@@ -311,6 +475,7 @@ void ReclaimPriorityManager::SetBundleState(int accountId, int uid, BundleState
             if (pairPtr->second != nullptr) {
                 auto bundlePtr = pairPtr->second;
                 bundlePtr->SetState(state);
+                MarkBundlePrioSnapshotDirty();
             }
         }
     }
@@ -391,6 +556,10 @@ bool ReclaimPriorityManager::UpdateReclaimPriority(UpdateRequest request)
         return false;
     }
     int64_t eventTime = KernelInterface::GetInstance().GetSystemTimeMs();
+    // ability start is never delayed, events before it are told apart by eventTime
+    if (updateCoalesceWindowMs_ > 0 && request.reason != AppStateUpdateReason::ABILITY_START) {
+        return PostCoalescedUpdate(request, eventTime);
+    }
     std::function<void()> updateReclaimPriorityInnerFunc =
                         [this, request, eventTime] { this->UpdateReclaimPriorityInner(request, eventTime); };
     if (request.reason == AppStateUpdateReason::ABILITY_START) {
@@ -400,6 +569,114 @@ bool ReclaimPriorityManager::UpdateReclaimPriority(UpdateRequest request)
     }
 }
 
+bool ReclaimPriorityManager::IsCoalescibleReason(AppStateUpdateReason reason)
+{
+    // extension binding changes priorities of other processes, it is never coalesced
+    if (reason == AppStateUpdateReason::BIND_EXTENSION || reason == AppStateUpdateReason::UNBIND_EXTENSION) {
+        return false;
+    }
+    return changeProcMapping_.find(reason) != changeProcMapping_.end();
+}
+
+bool ReclaimPriorityManager::PostCoalescedUpdate(const UpdateRequest &request, int64_t eventTime)
+{
+    // flushes and other updates are posted at the default priority, so they keep their order with
+    // each other and never jump ahead of lane tasks already queued
+    std::lock_guard<std::mutex> lock(pendingUpdatesLock_);
+    if (IsCoalescibleReason(request.reason)) {
+        pendingUpdates_.push_back({request, eventTime});
+        if (pendingUpdates_.size() > 1) {
+            return true; // flush of current window has been posted
+        }
+        return handler_->PostTask([this] { this->FlushCoalescedUpdates(); }, updateCoalesceWindowMs_);
+    }
+    // updates pending now are applied ahead of this one, the same order as they arrived
+    auto updates = std::make_shared<std::vector<PendingUpdate>>();
+    updates->swap(pendingUpdates_);
+    return handler_->PostTask([this, updates, request, eventTime] {
+        std::lock_guard<std::mutex> setLock(totalBundlePrioSetLock_);
+        ApplyCoalescedUpdates(*updates);
+        UpdateRequest currRequest = request;
+        HandleUpdateRequest(currRequest, eventTime);
+        MarkBundlePrioSnapshotDirty();
+    });
+}
+
+void ReclaimPriorityManager::FlushCoalescedUpdates()
+{
+    std::vector<PendingUpdate> updates;
+    {
+        std::lock_guard<std::mutex> lock(pendingUpdatesLock_);
+        updates.swap(pendingUpdates_);
+    }
+    if (updates.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> setLock(totalBundlePrioSetLock_);
+    ApplyCoalescedUpdates(updates);
+    MarkBundlePrioSnapshotDirty();
+}
+
+// add lock before use this function
+void ReclaimPriorityManager::ApplyCoalescedUpdates(const std::vector<PendingUpdate> &updates)
+{
+    if (updates.empty()) {
+        return;
+    }
+    struct DirtyProc {
+        std::shared_ptr<BundlePriorityInfo> bundle;
+        pid_t pid;
+        AppAction action;
+    };
+    // state of processes is changed event by event, priorities are computed once for each process
+    std::vector<DirtyProc> dirtyProcs;
+    for (const PendingUpdate &update : updates) {
+        const ReqProc &target = update.request.target;
+        AppStateUpdateReason reason = update.request.reason;
+        int accountId = GetOsAccountIdByUid(target.uid);
+        if (!IsProcExist(target.pid, target.uid, accountId)) {
+            HILOGE("process not exist and not to create it!!");
+            continue;
+        }
+        std::shared_ptr<BundlePriorityInfo> bundle = FindOsAccountById(accountId)->FindBundleById(target.uid);
+        if (bundle->priority_ <= RECLAIM_PRIORITY_KILLABLE_SYSTEM) {
+            continue;
+        }
+        ProcessPriorityInfo &proc = bundle->FindProcByPid(target.pid);
+        AppAction action = AppAction::OTHERS;
+        auto it = changeProcMapping_.find(reason);
+        if (it != changeProcMapping_.end()) {
+            (this->*(it->second))(proc, action, update.eventTime);
+        }
+        if (NeedSkipEventBeforeAbilityStart(proc, reason, update.eventTime)) {
+            HILOGI("this event<pid=%{public}d,uid=%{public}d,reason=%{public}s> should execute befor startAbility "
+                "event, skip update priority.", proc.pid_, proc.uid_, AppStateUpdateResonToString(reason).c_str());
+            continue;
+        }
+        auto dirty = std::find_if(dirtyProcs.begin(), dirtyProcs.end(),
+            [&bundle, &target](const DirtyProc &item) { return item.bundle == bundle && item.pid == target.pid; });
+        if (dirty == dirtyProcs.end()) {
+            dirtyProcs.push_back({bundle, target.pid, action});
+        } else if (action != AppAction::OTHERS) {
+            dirty->action = action; // the last foreground or background action wins
+        }
+    }
+    std::vector<std::shared_ptr<BundlePriorityInfo>> dirtyBundles;
+    for (DirtyProc &dirty : dirtyProcs) {
+        UpdatePriorityByProcStatus(dirty.bundle, dirty.bundle->FindProcByPid(dirty.pid));
+        NotifyReclaimStrategy(dirty.bundle, dirty.pid, dirty.action);
+        if (std::find(dirtyBundles.begin(), dirtyBundles.end(), dirty.bundle) == dirtyBundles.end()) {
+            dirtyBundles.push_back(dirty.bundle);
+        }
+    }
+    for (auto &bundle : dirtyBundles) {
+        OomScoreAdjUtils::WriteOomScoreAdjToKernel(bundle);
+    }
+    coalescedUpdateCount_ += updates.size();
+    coalescedApplyCount_ += dirtyProcs.size();
+    HILOGD("%{public}zu updates applied to %{public}zu processes", updates.size(), dirtyProcs.size());
+}
+
 bool ReclaimPriorityManager::UpdateRecalimPrioritySyncWithLock(const UpdateRequest &request)
 {
     if (!initialized_) {
@@ -411,7 +688,9 @@ bool ReclaimPriorityManager::UpdateRecalimPrioritySyncWithLock(const UpdateReque
 
     if (request.reason == AppStateUpdateReason::ABILITY_START) {
         int64_t eventTime = KernelInterface::GetInstance().GetSystemTimeMs();
-        return HandleAbilityStart(request, eventTime);
+        bool ret = HandleAbilityStart(request, eventTime);
+        MarkBundlePrioSnapshotDirty();
+        return ret;
     }
     return true;
 }
@@ -459,18 +738,25 @@ bool ReclaimPriorityManager::HandleAbilityStart(const UpdateRequest &request, in
 
 void ReclaimPriorityManager::SetTimerForAbilityStartCompletedCheck(pid_t pid, int32_t bundleUid, int32_t accountId)
 {
-    std::string taskName = std::to_string(pid) + AppStateUpdateResonToString(AppStateUpdateReason::ABILITY_START);
-    handler_->PostTask(
-        [this, pid, bundleUid, accountId] { this->CheckAbilityStartCompleted(pid, bundleUid, accountId); },
-        taskName, TIMER_ABILITY_START_CHECK_MS, AppExecFwk::EventQueue::Priority::LOW);
+    // the id is known only after the timer is added, the callback reads it when fired
+    auto timerId = std::make_shared<TimerWheel::TimerId>(0);
+    *timerId = AddTimer(TIMER_ABILITY_START_CHECK_MS, [this, pid, bundleUid, accountId, timerId] {
+        this->CheckAbilityStartCompleted(pid, bundleUid, accountId, *timerId);
+    });
+    abilityStartTimers_[pid] = *timerId;
     HILOGI("set process<pid=%{public}d,uid=%{public}d> ability start check timer after %{public}d ms",
         pid, bundleUid, TIMER_ABILITY_START_CHECK_MS);
 }
 
-void ReclaimPriorityManager::CheckAbilityStartCompleted(pid_t pid, int32_t bundleUid, int32_t accountId)
+void ReclaimPriorityManager::CheckAbilityStartCompleted(pid_t pid, int32_t bundleUid, int32_t accountId,
+    TimerWheel::TimerId timerId)
 {
     // add lock
     std::lock_guard<std::mutex> lock(totalBundlePrioSetLock_);
+    auto it = abilityStartTimers_.find(pid);
+    if (it != abilityStartTimers_.end() && it->second == timerId) {
+        abilityStartTimers_.erase(it); // fired, not replaced by a later timer of the process
+    }
 
     if (!IsProcExist(pid, bundleUid, accountId)) {
         return;
@@ -486,6 +772,7 @@ void ReclaimPriorityManager::CheckAbilityStartCompleted(pid_t pid, int32_t bundl
     }
 
     AbilityStartingEnd(proc, bundle, true);
+    MarkBundlePrioSnapshotDirty();
 }
 
 sptr<AppExecFwk::IBundleMgr> GetBundleMgr()
@@ -509,10 +796,18 @@ sptr<AppExecFwk::IBundleMgr> GetBundleMgr()
 
 bool ReclaimPriorityManager::IsKillableSystemApp(std::shared_ptr<BundlePriorityInfo> bundle)
 {
-    if (allKillableSystemApps_.find(bundle->name_) != allKillableSystemApps_.end()) {
+    if (killableSystemAppIds_.count(bundle->name_.GetId()) > 0) {
         HILOGD("find bundle (%{public}s) in killable system app list", bundle->name_.c_str());
         return true;
     }
+    {
+        std::lock_guard<std::mutex> lock(keepAliveCacheLock_);
+        auto it = keepAliveCache_.find(bundle->uid_);
+        if (it != keepAliveCache_.end()) {
+            keepAliveCacheHits_++;
+            return it->second;
+        }
+    }
 
     sptr<AppExecFwk::IBundleMgr> bmsPtr = GetBundleMgr();
     if (bmsPtr == nullptr) {
@@ -526,12 +821,10 @@ bool ReclaimPriorityManager::IsKillableSystemApp(std::shared_ptr<BundlePriorityI
     if (result) {
         HILOGD("appInfo<%{public}s,%{public}d><keepAlive=%{public}d, isSystemApp=%{public}d, isLauncherApp=%{public}d>",
             bundle->name_.c_str(), bundle->uid_, info.keepAlive, info.isSystemApp, info.isLauncherApp);
-        if (info.keepAlive) {
-            auto ret = allKillableSystemApps_.insert(bundle->name_);
-            if (ret.second) {
-                HILOGD("add a new killable system app (%{public}s)", bundle->name_.c_str());
-            }
-        }
+        // memoized per uid instead of added to the killable list, so that it is dropped when the package changes
+        std::lock_guard<std::mutex> lock(keepAliveCacheLock_);
+        keepAliveCache_[bundle->uid_] = info.keepAlive;
+        keepAliveQueries_++;
         return info.keepAlive;
     } else {
         HILOGE("bundleMgr GetApplicationInfo failed!");
@@ -542,15 +835,17 @@ bool ReclaimPriorityManager::IsKillableSystemApp(std::shared_ptr<BundlePriorityI
 void ReclaimPriorityManager::UpdateBundlePriority(std::shared_ptr<BundlePriorityInfo> bundle)
 {
     HILOGD("begin-------------------------");
-    DeleteBundleInfoFromSet(bundle);
     bundle->UpdatePriority();
-    AddBundleInfoToSet(bundle);
+    if (!totalBundlePrioSet_.Update(bundle)) {
+        AddBundleInfoToSet(bundle);
+    }
     HILOGD("end----------------------------");
 }
 
 void ReclaimPriorityManager::CheckCreateProcPriorityDelay(pid_t pid, int uid)
 {
     HILOGD("begin update after 15s-------------------------");
+    std::lock_guard<std::mutex> setLock(totalBundlePrioSetLock_);
 
     int accountId = GetOsAccountIdByUid(uid);
     if (!IsProcExist(pid, uid, accountId)) {
@@ -572,6 +867,7 @@ void ReclaimPriorityManager::CheckCreateProcPriorityDelay(pid_t pid, int uid)
     
     ProcessPriorityInfo &proc = bundle->FindProcByPid(pid);
     UpdatePriorityByProcStatus(bundle, proc);
+    MarkBundlePrioSnapshotDirty();
     OomScoreAdjUtils::WriteOomScoreAdjToKernel(bundle);
     HILOGD("end update after 15s----------------------------");
 }
@@ -613,13 +909,14 @@ bool ReclaimPriorityManager::HandleCreateProcess(ReqProc &target, int accountId,
     bundle->AddProc(proc);
     UpdateBundlePriority(bundle);
     account->AddBundleToOsAccount(bundle);
+    OomScoreAdjUtils::ForgetProcess(target.pid); // the pid may be reused
+    ProcessHandleTable::GetInstance().Register(target.pid, target.uid);
     //set timer for process check
     if (handler_ != nullptr) {
         pid_t pid = target.pid;
         int uid = target.uid;
         HILOGI("set timer for process check\n");
-        handler_->PostTask([this, pid, uid] { this->CheckCreateProcPriorityDelay(pid, uid);},
-            TIMER_DELAY_MS, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+        AddTimer(TIMER_DELAY_MS, [this, pid, uid] { this->CheckCreateProcPriorityDelay(pid, uid); });
     }
     bool ret = ApplyReclaimPriority(bundle, target.pid, action);
     HILOGI("create: bundleName=%{public}s, prio=%{public}d", target.bundleName.c_str(), bundle->priority_);
@@ -634,6 +931,9 @@ bool ReclaimPriorityManager::HandleTerminateProcess(ProcessPriorityInfo proc,
     // clear proc and bundle if needed, delete the object
     int removedProcessPrio = proc.priority_;
     bundle->RemoveProcByPid(proc.pid_);
+    RemoveTimerForAbilityStartCompletedCheck(proc);
+    ProcessHandleTable::GetInstance().Unregister(proc.pid_);
+    OomScoreAdjUtils::ForgetProcess(proc.pid_);
     bool ret = true;
 
     if (bundle->GetProcsCount() == 0) {
@@ -653,7 +953,49 @@ bool ReclaimPriorityManager::HandleTerminateProcess(ProcessPriorityInfo proc,
 
 void ReclaimPriorityManager::SetTimerForDiedProcessCheck(int64_t delayTime)
 {
-    handler_->PostTask([this] { this->HandleDiedProcessCheck(); }, delayTime, AppExecFwk::EventQueue::Priority::LOW);
+    AddTimer(delayTime, [this] { this->HandleDiedProcessCheck(); });
+}
+
+TimerWheel::TimerId ReclaimPriorityManager::AddTimer(int64_t delayMs, TimerWheel::Callback callback)
+{
+    TimerWheel::TimerId id = timerWheel_.Schedule(GetSteadyTimeMs(), delayMs, std::move(callback));
+    ArmTimerWheel();
+    return id;
+}
+
+void ReclaimPriorityManager::ArmTimerWheel()
+{
+    if (handler_ == nullptr) {
+        return;
+    }
+    int64_t wakeupMs = timerWheel_.NextWakeupMs();
+    if (wakeupMs < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(timerWheelArmLock_);
+    if (timerWheelArmedMs_ >= 0 && timerWheelArmedMs_ <= wakeupMs) {
+        return; // the tick task posted is early enough
+    }
+    timerWheelArmedMs_ = wakeupMs;
+    handler_->RemoveTask(TIMER_WHEEL_TASK);
+    handler_->PostTask([this] { this->HandleTimerWheelTick(); }, TIMER_WHEEL_TASK,
+        std::max<int64_t>(wakeupMs - GetSteadyTimeMs(), 0), AppExecFwk::EventQueue::Priority::LOW);
+}
+
+void ReclaimPriorityManager::HandleTimerWheelTick()
+{
+    {
+        std::lock_guard<std::mutex> lock(timerWheelArmLock_);
+        timerWheelArmedMs_ = -1;
+    }
+    std::vector<TimerWheel::Callback> expired;
+    timerWheel_.Advance(GetSteadyTimeMs(), expired);
+    HILOGD("%{public}zu timers expired", expired.size());
+    for (auto &callback : expired) {
+        callback();
+    }
+    timerWheelFiredCount_ += expired.size();
+    ArmTimerWheel();
 }
 
 void ReclaimPriorityManager::FilterDiedProcess()
@@ -669,9 +1011,13 @@ void ReclaimPriorityManager::FilterDiedProcess()
         if (bundle == nullptr) {
             continue;
         }
+        pid_t diedPid = 0;
         for (auto itrProcess = bundle->procs_.begin(); itrProcess != bundle->procs_.end();) {
             auto itProc = std::find(alivePids.begin(), alivePids.end(), itrProcess->second.pid_);
             if (itProc == alivePids.end()) {
+                diedPid = itrProcess->second.pid_;
+                ProcessHandleTable::GetInstance().Unregister(itrProcess->second.pid_);
+                OomScoreAdjUtils::ForgetProcess(itrProcess->second.pid_);
                 itrProcess = bundle->procs_.erase(itrProcess);
                 continue;
             } else {
@@ -683,6 +1029,8 @@ void ReclaimPriorityManager::FilterDiedProcess()
         if (bundle->GetProcsCount() == 0) {
             std::shared_ptr<AccountBundleInfo> account = FindOsAccountById(bundle->accountId_);
             if (account != nullptr) {
+                // the app memcg goes with the bundle, as on a terminate event
+                NotifyReclaimStrategy(bundle, diedPid, AppAction::APP_DIED);
                 account->RemoveBundleById(bundle->uid_);
                 itrBundle = totalBundlePrioSet_.erase(itrBundle);
                 continue;
@@ -690,6 +1038,7 @@ void ReclaimPriorityManager::FilterDiedProcess()
         }
         ++itrBundle;
     }
+    MarkBundlePrioSnapshotDirty();
 }
 
 void ReclaimPriorityManager::HandleDiedExtensionBindToMe(
@@ -722,9 +1071,58 @@ void ReclaimPriorityManager::HandleDiedExtensionBindFromMe(
     }
 }
 
+void ReclaimPriorityManager::HandleProcessExit(pid_t pid, int uid)
+{
+    std::lock_guard<std::mutex> lock(totalBundlePrioSetLock_);
+    if (ProcessHandleTable::GetInstance().IsRegistered(pid)) {
+        HILOGD("pid=%{public}d is reused, skip", pid);
+        return;
+    }
+    int accountId = GetOsAccountIdByUid(uid);
+    if (!IsProcExist(pid, uid, accountId)) {
+        return; // terminated by app state event already
+    }
+    std::shared_ptr<AccountBundleInfo> account = FindOsAccountById(accountId);
+    std::shared_ptr<BundlePriorityInfo> bundle = account->FindBundleById(uid);
+    ProcessPriorityInfo proc = bundle->FindProcByPid(pid);
+    for (const auto &pair : proc.procsBindToMe_) {
+        std::shared_ptr<BundlePriorityInfo> connectorBundle;
+        ProcessPriorityInfo *connector = FindExtensionGraphNode(pair.first, pair.second, connectorBundle);
+        if (connector != nullptr) {
+            connector->ProcUnBindFromMe(pid);
+        }
+    }
+    std::vector<std::pair<pid_t, int32_t>> extensions;
+    for (const auto &pair : proc.procsBindFromMe_) {
+        std::shared_ptr<BundlePriorityInfo> extensionBundle;
+        ProcessPriorityInfo *extension = FindExtensionGraphNode(pair.first, pair.second, extensionBundle);
+        if (extension != nullptr) {
+            extension->ProcUnBindToMe(pid);
+            extensions.emplace_back(pair.first, pair.second);
+        }
+    }
+    HILOGI("pid=%{public}d exited without terminated event", pid);
+    HandleTerminateProcess(proc, bundle, account);
+    // extensions lost a connector, their priorities may drop
+    for (const auto &item : extensions) {
+        std::shared_ptr<BundlePriorityInfo> extensionBundle;
+        ProcessPriorityInfo *extension = FindExtensionGraphNode(item.first, item.second, extensionBundle);
+        if (extension != nullptr) {
+            UpdatePriorityByProcForExtension(*extension);
+        }
+    }
+    MarkBundlePrioSnapshotDirty();
+}
+
 void ReclaimPriorityManager::HandleDiedProcessCheck()
 {
-    FilterDiedProcess();
+    // died processes are removed by exit notifications of pidfds, sweep /proc rarely if all of them are watched
+    bool sweep = !ProcessHandleTable::GetInstance().IsExitWatchComplete() ||
+        (diedProcCheckCount_++ % DIED_PROC_SWEEP_PERIOD) == 0;
+    if (sweep) {
+        FilterDiedProcess();
+    }
+    ProcessHandleTable::GetInstance().RefreshAll();
     if (totalBundlePrioSet_.size() > MAX_TOTALBUNDLESET_SIZE) {
         SetTimerForDiedProcessCheck(TIMER_DIED_PROC_FAST_CHECK_MS);
     } else {
@@ -800,119 +1198,51 @@ bool ReclaimPriorityManager::UpdateExtensionStatusForCaller(UpdateRequest &reque
     return true;
 }
 
-void ReclaimPriorityManager::GetConnectedExtensionProc(const ProcessPriorityInfo &proc, ProcInfoVec &procVec)
+ProcessPriorityInfo* ReclaimPriorityManager::FindExtensionGraphNode(pid_t pid, int32_t uid,
+    std::shared_ptr<BundlePriorityInfo> &bundle)
 {
-    std::set<int32_t> isExtensionProcVisitedSet;
-    std::queue<ProcessPriorityInfo> extensionProcQue;
-    extensionProcQue.push(proc);
-
-    while (!extensionProcQue.empty()) {
-        ProcessPriorityInfo extensionProc(extensionProcQue.front());
-        extensionProcQue.pop();
-        if (isExtensionProcVisitedSet.count(extensionProc.pid_)) {
-            continue;
-        }
-        if (extensionProc.isExtension_) {
-            procVec.push_back(extensionProc);
-            isExtensionProcVisitedSet.insert(extensionProc.pid_);
-        }
-
-        for (const auto &pair : extensionProc.procsBindFromMe_) {
-            if (isExtensionProcVisitedSet.count(pair.first)) {
-                continue;
-            }
-            int accountId = GetOsAccountIdByUid(pair.second);
-            if (!IsProcExist(pair.first, pair.second, accountId)) {
-                continue;
-            }
-            std::shared_ptr<AccountBundleInfo> account = FindOsAccountById(accountId);
-            std::shared_ptr<BundlePriorityInfo> bundle = account->FindBundleById(pair.second);
-            ProcessPriorityInfo &procBindFromMe = bundle->FindProcByPid(pair.first);
-            extensionProcQue.push(procBindFromMe);
-        }
+    int accountId = GetOsAccountIdByUid(uid);
+    if (!IsProcExist(pid, uid, accountId)) {
+        return nullptr;
     }
+    bundle = FindOsAccountById(accountId)->FindBundleById(uid);
+    return &bundle->FindProcByPid(pid);
 }
 
-void ReclaimPriorityManager::CalculateExtensionProcPrio(ProcInfoVec &procVec, ProcInfoSet &procSet)
+int ReclaimPriorityManager::CalculateExtensionPriority(const ProcessPriorityInfo &extension)
 {
-    for (auto &extensionProc : procVec) {
-        int32_t minExtensionPriority = RECLAIM_PRIORITY_BACKGROUND;
-        for (const auto &connectorProcPair : extensionProc.procsBindToMe_) {
-            int accountId = GetOsAccountIdByUid(connectorProcPair.second);
-            if (!IsProcExist(connectorProcPair.first, connectorProcPair.second, accountId)) {
-                minExtensionPriority = 0;
-                continue;
-            }
-
-            std::shared_ptr<AccountBundleInfo> connectorAccount = FindOsAccountById(accountId);
-            std::shared_ptr<BundlePriorityInfo> bundle = connectorAccount->FindBundleById(connectorProcPair.second);
-            ProcessPriorityInfo &procBindToMe = bundle->FindProcByPid(connectorProcPair.first);
-            minExtensionPriority =
-                minExtensionPriority < procBindToMe.priority_ ? minExtensionPriority : procBindToMe.priority_;
-        }
-
-        extensionProc.priority_ = minExtensionPriority;
-        procSet.insert(extensionProc);
+    int32_t minConnectorPriority = RECLAIM_PRIORITY_BACKGROUND;
+    for (const auto &connectorPair : extension.procsBindToMe_) {
+        std::shared_ptr<BundlePriorityInfo> connectorBundle;
+        ProcessPriorityInfo *connector = FindExtensionGraphNode(connectorPair.first, connectorPair.second,
+            connectorBundle);
+        // connector not managed by memmgr is a native process
+        int32_t connectorPriority = (connector == nullptr) ? 0 : std::max(connector->priority_, 0);
+        minConnectorPriority = std::min(minConnectorPriority, connectorPriority);
+    }
+    int priority = std::min(GetPriorityByProcStatus(extension), minConnectorPriority + EXTENSION_PRIORITY_DELTA);
+    if (extension.isImportant_ && priority > extension.priorityIfImportant_) {
+        priority = extension.priorityIfImportant_;
     }
+    return priority;
 }
 
-void ReclaimPriorityManager::SetConnectExtensionProcPrio(const ProcInfoSet &procSet)
+bool ReclaimPriorityManager::ApplyExtensionPriority(ProcessPriorityInfo &extension,
+    std::shared_ptr<BundlePriorityInfo> bundle)
 {
-    int32_t deltaPriority = 100;
-    for (const auto &extensionProcess : procSet) {
-        int32_t minExtensionPriority = RECLAIM_PRIORITY_BACKGROUND;
-        for (const auto &connectorProcPair : extensionProcess.procsBindToMe_) {
-            int accountId = GetOsAccountIdByUid(connectorProcPair.second);
-            if (!IsProcExist(connectorProcPair.first, connectorProcPair.second, accountId)) {
-                minExtensionPriority = 0;
-                continue;
-            }
-            std::shared_ptr<AccountBundleInfo> connectorAccount = FindOsAccountById(accountId);
-            std::shared_ptr<BundlePriorityInfo> bundle = connectorAccount->FindBundleById(connectorProcPair.second);
-            ProcessPriorityInfo &procBindToMe = bundle->FindProcByPid(connectorProcPair.first);
-            int32_t procBindToMePrio = procBindToMe.priority_ < 0 ? 0 : procBindToMe.priority_;
-            minExtensionPriority =
-                minExtensionPriority < procBindToMePrio ? minExtensionPriority : procBindToMePrio;
-        }
-
-        int extensionAccountId = GetOsAccountIdByUid(extensionProcess.uid_);
-        if (!IsProcExist(extensionProcess.pid_, extensionProcess.uid_, extensionAccountId)) {
-            continue;
-        }
-
-        std::shared_ptr<AccountBundleInfo> extensionAccount = FindOsAccountById(extensionAccountId);
-        std::shared_ptr<BundlePriorityInfo> extensionBundle = extensionAccount->FindBundleById(extensionProcess.uid_);
-        ProcessPriorityInfo &procExtensionUpdate = extensionBundle->FindProcByPid(extensionProcess.pid_);
-        int priorityAsApp = GetPriorityByProcStatus(procExtensionUpdate);
-        int priorityAsExtension = minExtensionPriority + deltaPriority;
-        int minPriority = priorityAsApp < priorityAsExtension ? priorityAsApp : priorityAsExtension;
-        procExtensionUpdate.SetPriority(minPriority);
-        if (procExtensionUpdate.isImportant_) {
-            SetImportantProcPriority(procExtensionUpdate);
-        }
-        UpdateBundlePriority(extensionBundle);
-        OomScoreAdjUtils::WriteOomScoreAdjToKernel(procExtensionUpdate.pid_, procExtensionUpdate.priority_);
+    int priority = CalculateExtensionPriority(extension);
+    if (priority == extension.priority_) {
+        return false;
     }
+    extension.SetPriority(priority);
+    UpdateBundlePriority(bundle);
+    OomScoreAdjUtils::WriteOomScoreAdjToKernel(extension.pid_, extension.priority_);
+    return true;
 }
 
 int ReclaimPriorityManager::GetPriorityByProcStatus(const ProcessPriorityInfo &proc)
 {
-    int priority = RECLAIM_PRIORITY_UNKNOWN;
-
-    if (!proc.isFreground && proc.hasUI_) {
-        priority = RECLAIM_PRIORITY_BACKGROUND;
-    }
-    if (proc.isFreground) {
-        priority = RECLAIM_PRIORITY_FOREGROUND;
-    } else if (proc.isVisible_) {
-        priority = RECLAIM_PRIORITY_VISIBLE;
-    } else if (proc.isSuspendDelay) {
-        priority = RECLAIM_PRIORITY_BG_SUSPEND_DELAY;
-    } else if (proc.isBackgroundRunning || proc.isEventStart) {
-        priority = RECLAIM_PRIORITY_BG_PERCEIVED;
-    } else if (proc.isDistDeviceConnected) {
-        priority = RECLAIM_PRIORITY_BG_DIST_DEVICE;
-    }
+    int priority = proc.GetPriorityByStatus();
 
     if (proc.isImportant_) {
         if (proc.priority_ >= proc.priorityIfImportant_) {
@@ -934,6 +1264,14 @@ bool ReclaimPriorityManager::UpdateReclaimPriorityInner(UpdateRequest request, i
 {
     // This function can only be called by UpdateReclaimPriority, otherwise it may deadlock.
     std::lock_guard<std::mutex> setLock(totalBundlePrioSetLock_);
+    bool ret = HandleUpdateRequest(request, eventTime);
+    MarkBundlePrioSnapshotDirty();
+    return ret;
+}
+
+// add lock before use this function
+bool ReclaimPriorityManager::HandleUpdateRequest(UpdateRequest &request, int64_t eventTime)
+{
     ReqProc target = request.target;
     int accountId = GetOsAccountIdByUid(target.uid);
     HILOGD("accountId=%{public}d", accountId);
@@ -982,9 +1320,13 @@ bool ReclaimPriorityManager::UpdateReclaimPriorityInner(UpdateRequest request, i
 
 bool ReclaimPriorityManager::IsImportantProc(const std::string procName, int &dstPriority)
 {
-    std::map<std::string, int> importantProcs = config_.GetImportantBgApps();
-    if (importantProcs.count(procName)) {
-        dstPriority = importantProcs.at(procName);
+    BundleNameTable::Id id = BundleNameTable::EMPTY_ID;
+    if (!BundleNameTable::GetInstance().Find(procName, id)) {
+        return false; // names of important processes are all interned
+    }
+    auto it = importantProcIds_.find(id);
+    if (it != importantProcIds_.end()) {
+        dstPriority = it->second;
         HILOGD("is an important proc, procName=%{public}s, importPriority=%{public}d", procName.c_str(), dstPriority);
         return true;
     }
@@ -1000,15 +1342,38 @@ void ReclaimPriorityManager::SetImportantProcPriority(ProcessPriorityInfo &proc)
 
 void ReclaimPriorityManager::UpdatePriorityByProcForExtension(ProcessPriorityInfo &proc)
 {
-    ProcInfoVec allConnectedExtensionProcVec;
-    GetConnectedExtensionProc(proc, allConnectedExtensionProcVec);
-    if (allConnectedExtensionProcVec.size() == 0) {
-        return;
+    struct GraphNode {
+        pid_t pid;
+        int32_t uid;
+        bool force; // its providers are revisited even if its priority is not changed
+    };
+    // edges of the graph are the bind maps of processes, from a connector to the extensions bound by it.
+    // an extension is revisited only when priority of one of its connectors is changed, so propagation
+    // stops at extensions not changed.
+    std::queue<GraphNode> worklist;
+    worklist.push({proc.pid_, proc.uid_, true});
+    std::map<pid_t, int> visits;
+    while (!worklist.empty()) {
+        GraphNode node = worklist.front();
+        worklist.pop();
+        // priorities only move towards a fixed point, a bound of visits is enough for cycles
+        if (++visits[node.pid] > MAX_EXTENSION_PROPAGATION_VISITS) {
+            HILOGW("extension pid=%{public}d is in a cycle, stop propagation", node.pid);
+            continue;
+        }
+        std::shared_ptr<BundlePriorityInfo> bundle;
+        ProcessPriorityInfo *curr = FindExtensionGraphNode(node.pid, node.uid, bundle);
+        if (curr == nullptr) {
+            continue;
+        }
+        bool changed = curr->isExtension_ && ApplyExtensionPriority(*curr, bundle);
+        if (!changed && !node.force) {
+            continue;
+        }
+        for (const auto &pair : curr->procsBindFromMe_) {
+            worklist.push({pair.first, pair.second, false});
+        }
     }
-    ProcInfoSet allConnectedExtensionProcSet;
-    CalculateExtensionProcPrio(allConnectedExtensionProcVec, allConnectedExtensionProcSet);
-
-    SetConnectExtensionProcPrio(allConnectedExtensionProcSet);
 }
 
 void ReclaimPriorityManager::UpdatePriorityByProcConnector(ProcessPriorityInfo &proc)
@@ -1220,13 +1585,19 @@ bool ReclaimPriorityManager::ApplyReclaimPriority(std::shared_ptr<BundlePriority
         HILOGD("bundle is nullptr");
         return false;
     }
+    NotifyReclaimStrategy(bundle, pid, action);
+    return OomScoreAdjUtils::WriteOomScoreAdjToKernel(bundle);
+}
+
+void ReclaimPriorityManager::NotifyReclaimStrategy(std::shared_ptr<BundlePriorityInfo> bundle,
+    pid_t pid, AppAction action)
+{
 #ifdef USE_HYPERHOLD_MEMORY
     DECLARE_SHARED_POINTER(ReclaimParam, para);
-    MAKE_POINTER(para, shared, ReclaimParam, "make ReclaimParam failed", return false,
+    MAKE_POINTER(para, shared, ReclaimParam, "make ReclaimParam failed", return,
         pid, bundle->uid_, bundle->name_, bundle->accountId_, bundle->priority_, action);
     ReclaimStrategyManager::GetInstance().NotifyAppStateChanged(para);
 #endif
-    return OomScoreAdjUtils::WriteOomScoreAdjToKernel(bundle);
 }
 
 bool ReclaimPriorityManager::OsAccountChanged(int accountId, AccountSA::OS_ACCOUNT_SWITCH_MOD switchMod)
@@ -1246,7 +1617,19 @@ bool ReclaimPriorityManager::OsAccountChanged(int accountId, AccountSA::OS_ACCOU
 
 bool ReclaimPriorityManager::OsAccountChangedInner(int accountId, AccountSA::OS_ACCOUNT_SWITCH_MOD switchMod)
 {
-    return UpdateAllPrioForOsAccountChanged(accountId, switchMod);
+    std::lock_guard<std::mutex> setLock(totalBundlePrioSetLock_);
+    bool ret = UpdateAllPrioForOsAccountChanged(accountId, switchMod);
+    // priorities of bundles may be changed by account switching, move them to their new buckets
+    for (auto &accountPair : osAccountsInfoMap_) {
+        if (accountPair.second == nullptr) {
+            continue;
+        }
+        for (auto &bundlePair : accountPair.second->bundleIdInfoMapping_) {
+            totalBundlePrioSet_.Update(bundlePair.second);
+        }
+    }
+    MarkBundlePrioSnapshotDirty();
+    return ret;
 }
 
 bool ReclaimPriorityManager::UpdateAllPrioForOsAccountChanged(int accountId,
@@ -1264,12 +1647,36 @@ bool ReclaimPriorityManager::UpdateAllPrioForOsAccountChanged(int accountId,
 void ReclaimPriorityManager::Reset()
 {
     // add locks
+    {
+        std::lock_guard<std::mutex> lock(pendingUpdatesLock_);
+        pendingUpdates_.clear();
+    }
     std::lock_guard<std::mutex> setLock(totalBundlePrioSetLock_);
 
     HILOGI("clear totalBundlePrioSet(size: %{public}zu) and osAccountslnfoMap(size: %{public}zu) ",
         totalBundlePrioSet_.size(), osAccountsInfoMap_.size());
+    for (const auto &bundle : totalBundlePrioSet_) {
+        // apps go with AppMgr, their memcgs are not tracked by any bundle any more
+        if (bundle != nullptr) {
+            NotifyReclaimStrategy(bundle, bundle->procs_.empty() ? 0 : bundle->procs_.begin()->first,
+                AppAction::APP_DIED);
+        }
+    }
     totalBundlePrioSet_.clear();
     osAccountsInfoMap_.clear();
+    for (auto &pair : abilityStartTimers_) {
+        timerWheel_.Cancel(pair.second);
+    }
+    abilityStartTimers_.clear();
+    ProcessHandleTable::GetInstance().Clear();
+    OomScoreAdjUtils::ClearCache();
+    bundlePrioSnapshotBuilder_.Reset();
+    MarkBundlePrioSnapshotDirty();
+    {
+        // callbacks are lost while AppMgr is away, the set is verified again once it reconnects
+        std::lock_guard<std::mutex> lock(foregroundAppsLock_);
+        foregroundAppsSynced_ = false;
+    }
 }
 
 bool ReclaimPriorityManager::CheckCurrentEventHappenedBeforeAbilityStart(const ProcessPriorityInfo &proc,
@@ -1286,11 +1693,12 @@ bool ReclaimPriorityManager::CheckCurrentEventHappenedBeforeAbilityStart(const P
 
 void ReclaimPriorityManager::RemoveTimerForAbilityStartCompletedCheck(const ProcessPriorityInfo &proc)
 {
-    if (handler_ == nullptr) {
+    auto it = abilityStartTimers_.find(proc.pid_);
+    if (it == abilityStartTimers_.end()) {
         return;
     }
-    handler_->RemoveTask(std::to_string(proc.pid_) +
-        AppStateUpdateResonToString(AppStateUpdateReason::ABILITY_START));
+    timerWheel_.Cancel(it->second);
+    abilityStartTimers_.erase(it);
 }
 
 // set priority of proc to RECLAIM_PRIORITY_FOREGROUND when proc is starting ability
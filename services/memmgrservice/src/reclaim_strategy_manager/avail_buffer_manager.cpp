@@ -52,8 +52,8 @@ bool AvailBufferManager::Init()
 bool AvailBufferManager::GetEventHandler()
 {
     if (!handler_) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
-            AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return false,
+            ExecutorLane::RECLAIM);
     }
     return true;
 }
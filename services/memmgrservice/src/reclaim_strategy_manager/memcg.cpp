@@ -13,7 +13,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
 #include <regex>
+#include <unistd.h>
+#include <unordered_set>
 
 #include "memmgr_log.h"
 #include "kernel_interface.h"
@@ -24,6 +29,42 @@ namespace OHOS {
 namespace Memory {
 namespace {
 const std::string TAG = "Memcg";
+
+// zram is spelled differently by kernel versions, refaults are split into anon and file by newer ones
+enum MemcgStatKey {
+    STAT_ANON,
+    STAT_ZRAM,
+    STAT_ZRAM_UPPER,
+    STAT_ESWAP,
+    STAT_REFAULT,
+    STAT_REFAULT_ANON,
+    STAT_REFAULT_FILE,
+    STAT_KEY_COUNT
+};
+const char * const MEMCG_STAT_KEYS[STAT_KEY_COUNT] = {
+    "Anon", "zram", "Zram", "Eswap", "workingset_refault", "workingset_refault_anon", "workingset_refault_file"
+};
+
+bool FillMemcgStat(const long long values[], MemcgStat &stat)
+{
+    long long zram = values[STAT_ZRAM] >= 0 ? values[STAT_ZRAM] : values[STAT_ZRAM_UPPER];
+    if (values[STAT_ANON] < 0 || zram < 0 || values[STAT_ESWAP] < 0) {
+        return false;
+    }
+    stat.anonKiB = values[STAT_ANON];
+    stat.zramKiB = zram;
+    stat.eswapKiB = values[STAT_ESWAP];
+    stat.refaultsValid = true;
+    if (values[STAT_REFAULT] >= 0) {
+        stat.refaults = values[STAT_REFAULT];
+    } else if (values[STAT_REFAULT_ANON] >= 0 || values[STAT_REFAULT_FILE] >= 0) {
+        stat.refaults = std::max(values[STAT_REFAULT_ANON], 0LL) + std::max(values[STAT_REFAULT_FILE], 0LL);
+    } else {
+        stat.refaults = 0;
+        stat.refaultsValid = false;
+    }
+    return true;
+}
 } // namespace
 
 SwapInfo::SwapInfo()
@@ -143,33 +184,43 @@ bool Memcg::UpdateMemInfoFromKernel()
         HILOGE("memInfo_ nullptr");
         return false;
     }
-    std::string path = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(), "memory.stat");
-    std::string content;
-    if (!KernelInterface::GetInstance().ReadFromFile(path, content)) {
-        HILOGE("file not found. %{public}s", path.c_str());
+    MemcgStat stat;
+    if (!ReadMemcgStat(stat)) {
         return false;
     }
-    content = std::regex_replace(content, std::regex("\n+"), " "); // replace \n with space
-    std::regex re(".*Anon:[[:s:]]*([[:d:]]+) kB[[:s:]]*"
-                  ".*[zZ]ram:[[:s:]]*([[:d:]]+) kB[[:s:]]*"
-                  "Eswap:[[:s:]]*([[:d:]]+) kB[[:s:]]*");
-    std::smatch res;
-    if (!std::regex_match(content, res, re)) {
-        HILOGI("re not match. %{public}s", content.c_str());
+    memInfo_->anonKiB_ = static_cast<unsigned int>(stat.anonKiB);
+    memInfo_->zramKiB_ = static_cast<unsigned int>(stat.zramKiB);
+    memInfo_->eswapKiB_ = static_cast<unsigned int>(stat.eswapKiB);
+    HILOGI("success. %{public}s", memInfo_->ToString().c_str());
+    return true;
+}
+
+bool Memcg::ReadMemcgStat(MemcgStat &stat)
+{
+    if (statReader_ == nullptr) {
+        std::string path = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(), "memory.stat");
+        statReader_ = std::make_unique<KvFileReader>(path);
+    }
+    long long values[STAT_KEY_COUNT];
+    std::fill(values, values + STAT_KEY_COUNT, -1);
+    if (statReader_->ReadValues(MEMCG_STAT_KEYS, values, STAT_KEY_COUNT) < 0) {
         return false;
     }
-    try {
-        memInfo_->anonKiB_ = (unsigned int)std::stoi(res.str(1)); // 1: anonKiB index
-        memInfo_->zramKiB_ = (unsigned int)std::stoi(res.str(2)); // 2: zramKiB index
-        memInfo_->eswapKiB_ = (unsigned int)std::stoi(res.str(3)); // 3: eswapKiB index
-    } catch (std::out_of_range&) {
-        HILOGE("stoi() failed: out_of_range");
+    if (!FillMemcgStat(values, stat)) {
+        HILOGI("anon, zram or eswap not found in %{public}s", statReader_->GetPath().c_str());
         return false;
     }
-    HILOGI("success. %{public}s", memInfo_->ToString().c_str());
     return true;
 }
 
+bool Memcg::ParseMemcgStat(const char *buf, size_t len, MemcgStat &stat)
+{
+    long long values[STAT_KEY_COUNT];
+    std::fill(values, values + STAT_KEY_COUNT, -1);
+    KvFileReader::ParseValues(buf, len, MEMCG_STAT_KEYS, values, STAT_KEY_COUNT);
+    return FillMemcgStat(values, stat);
+}
+
 void Memcg::SetScore(int score)
 {
     score_ = score;
@@ -202,33 +253,77 @@ bool Memcg::SetScoreAndReclaimRatiosToKernel()
         HILOGE("reclaimRatios_ nullptr");
         return false;
     }
-    bool ret = false;
+    bool ret = true;
     // write score
-    std::string scorePath = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(), "memory.app_score");
-    ret = WriteToFile_(scorePath, std::to_string(score_));
+    if (!applied_.scoreValid || applied_.score != score_) {
+        std::string scorePath = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(), "memory.app_score");
+        ret = WriteToFile_(scorePath, std::to_string(score_));
+        applied_.scoreValid = ret;
+        applied_.score = score_;
+    }
     // write reclaim ratios
-    std::string ratiosPath = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(),
-        "memory.zswapd_single_memcg_param");
-    ret = ret && WriteToFile_(ratiosPath, reclaimRatios_->NumsToString());
-    // double check: check file content
+    if (ret && !RatiosApplied_()) {
+        std::string ratiosPath = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(),
+            "memory.zswapd_single_memcg_param");
+        ret = WriteToFile_(ratiosPath, reclaimRatios_->NumsToString());
+        applied_.ratiosValid = ret;
+        applied_.mem2zramRatio = reclaimRatios_->mem2zramRatio_;
+        applied_.zram2ufsRatio = reclaimRatios_->zram2ufsRatio_;
+        applied_.refaultThreshold = reclaimRatios_->refaultThreshold_;
+    }
+    applied_.writeFailed = !ret;
+    return ret;
+}
+
+bool Memcg::RatiosApplied_() const
+{
+    return applied_.ratiosValid && applied_.mem2zramRatio == reclaimRatios_->mem2zramRatio_ &&
+        applied_.zram2ufsRatio == reclaimRatios_->zram2ufsRatio_ &&
+        applied_.refaultThreshold == reclaimRatios_->refaultThreshold_;
+}
+
+void Memcg::ResetAppliedParams_()
+{
+    applied_ = AppliedParams();
+}
+
+bool Memcg::ReconcileWithKernel()
+{
+    if (reclaimRatios_ == nullptr) {
+        HILOGE("reclaimRatios_ nullptr");
+        return false;
+    }
+    if (applied_.writeFailed) {
+        return SetScoreAndReclaimRatiosToKernel();
+    }
+    if (!applied_.scoreValid && !applied_.ratiosValid) { // never written, kernel defaults are in use
+        return true;
+    }
     int score = 0;
     unsigned int mem2zramRatio = 0;
     unsigned int zram2ufsRatio = 0;
     unsigned int refaultThreshold = 0;
     if (!ReadScoreAndReclaimRatiosFromKernel_(score, mem2zramRatio, zram2ufsRatio, refaultThreshold)) {
-        return ret;
-    }
-    ret = ret && (score_ == score);
-    ret = ret && (reclaimRatios_->mem2zramRatio_ == mem2zramRatio);
-    ret = ret && (reclaimRatios_->zram2ufsRatio_ == zram2ufsRatio);
-    ret = ret && (reclaimRatios_->refaultThreshold_ == refaultThreshold);
-    if (ret == false) { // if values of mem and kernel not matched, using kernel values
-        score_ = score;
-        reclaimRatios_->mem2zramRatio_ = mem2zramRatio;
-        reclaimRatios_->zram2ufsRatio_ = zram2ufsRatio;
-        reclaimRatios_->refaultThreshold_ = refaultThreshold;
+        return false;
     }
-    return ret;
+    if (applied_.score == score && applied_.mem2zramRatio == mem2zramRatio &&
+        applied_.zram2ufsRatio == zram2ufsRatio && applied_.refaultThreshold == refaultThreshold) {
+        return true;
+    }
+    HILOGI("%{public}s changed out of memmgr, score=%{public}d ratios=%{public}u %{public}u %{public}u",
+        GetMemcgPath_().c_str(), score, mem2zramRatio, zram2ufsRatio, refaultThreshold);
+    // if values of mem and kernel not matched, using kernel values
+    score_ = score;
+    reclaimRatios_->mem2zramRatio_ = mem2zramRatio;
+    reclaimRatios_->zram2ufsRatio_ = zram2ufsRatio;
+    reclaimRatios_->refaultThreshold_ = refaultThreshold;
+    applied_.scoreValid = true;
+    applied_.ratiosValid = true;
+    applied_.score = score;
+    applied_.mem2zramRatio = mem2zramRatio;
+    applied_.zram2ufsRatio = zram2ufsRatio;
+    applied_.refaultThreshold = refaultThreshold;
+    return false;
 }
 
 bool Memcg::SwapIn()
@@ -240,6 +335,77 @@ bool Memcg::SwapIn()
     return ret;
 }
 
+int Memcg::AddProcs(const std::vector<unsigned int>& pids, bool verify)
+{
+    if (pids.empty()) {
+        return 0;
+    }
+    std::string procsPath = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(), "cgroup.procs");
+    int fd = open(procsPath.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        HILOGE("open %{public}s failed, errno=%{public}d", procsPath.c_str(), errno);
+        return 0;
+    }
+    // each write moves one pid, so writes sharing the fd can be done in any order
+    std::vector<BatchWriteEntry> entries(pids.size());
+    for (size_t i = 0; i < pids.size(); i++) {
+        entries[i].fd = fd;
+        entries[i].content = std::to_string(pids[i]);
+    }
+    int added = KernelInterface::GetInstance().BatchWrite(entries);
+    close(fd);
+    std::vector<unsigned int> addedPids;
+    addedPids.reserve(pids.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].error != 0) {
+            HILOGD("add pid=%{public}u to %{public}s failed, errno=%{public}d", pids[i], procsPath.c_str(),
+                entries[i].error);
+            continue;
+        }
+        addedPids.push_back(pids[i]);
+    }
+    if (verify && !addedPids.empty()) {
+        int missing = CountProcsMissing_(procsPath, addedPids);
+        HILOGI("%{public}d of %{public}zu pids added to %{public}s, %{public}d of them not in it now",
+            added, pids.size(), procsPath.c_str(), missing);
+    } else {
+        HILOGD("%{public}d of %{public}zu pids added to %{public}s", added, pids.size(), procsPath.c_str());
+    }
+    return added;
+}
+
+int Memcg::CountProcsMissing_(const std::string& procsPath, const std::vector<unsigned int>& pids)
+{
+    std::string content;
+    if (!KernelInterface::GetInstance().ReadFromFile(procsPath, content)) {
+        HILOGE("read %{public}s failed", procsPath.c_str());
+        return static_cast<int>(pids.size());
+    }
+    std::unordered_set<unsigned int> procs;
+    unsigned int pid = 0;
+    bool inNumber = false;
+    for (char c : content) {
+        if (c >= '0' && c <= '9') {
+            pid = pid * 10 + static_cast<unsigned int>(c - '0'); // 10: decimal
+            inNumber = true;
+        } else if (inNumber) {
+            procs.insert(pid);
+            pid = 0;
+            inNumber = false;
+        }
+    }
+    if (inNumber) {
+        procs.insert(pid);
+    }
+    int missing = 0;
+    for (unsigned int added : pids) {
+        if (procs.count(added) == 0) {
+            missing++; // exited or moved by others after it is added
+        }
+    }
+    return missing;
+}
+
 inline std::string Memcg::GetMemcgPath_()
 {
     // memcg dir: "/dev/memcg"
@@ -305,6 +471,7 @@ bool UserMemcg::CreateMemcgDir()
         HILOGE("failed. %{public}s", fullPath.c_str());
         return false;
     }
+    ResetAppliedParams_();
     HILOGI("success. %{public}s", fullPath.c_str());
     return true;
 }
@@ -328,16 +495,55 @@ std::string UserMemcg::GetMemcgPath_()
 
 bool UserMemcg::AddProc(unsigned int pid)
 {
-    std::string fullPath = KernelInterface::GetInstance().JoinPath(GetMemcgPath_(), "cgroup.procs");
-    bool ret = WriteToFile_(fullPath, std::to_string(pid), false);
-    // double check file content
-    bool dirExists = KernelInterface::GetInstance().IsDirExists(GetMemcgPath_());
-    bool fileExists = KernelInterface::GetInstance().IsFileExists(fullPath);
-    std::string content;
-    KernelInterface::GetInstance().ReadFromFile(fullPath, content);
-    content = std::regex_replace(content, std::regex("\n+"), " "); // replace \n with space
-    HILOGI("dir:%{public}s exist=%{public}d. file:%{public}s exist=%{public}d content=*%{public}s* ret=%{public}d",
-           GetMemcgPath_().c_str(), dirExists, fullPath.c_str(), fileExists, content.c_str(), ret);
+    bool ret = AddProcs({ pid }) == 1;
+    HILOGI("add pid=%{public}u to %{public}s %{public}s", pid, GetMemcgPath_().c_str(), ret ? "succ" : "fail");
+    return ret;
+}
+
+AppMemcg::AppMemcg(unsigned int userId, int appUid) : userId_(userId), appUid_(appUid)
+{
+    HILOGI("init AppMemcg success");
+}
+
+AppMemcg::~AppMemcg()
+{
+    HILOGI("release AppMemcg success");
+}
+
+bool AppMemcg::CreateMemcgDir()
+{
+    std::string fullPath = GetMemcgPath_();
+    if (!KernelInterface::GetInstance().CreateDir(fullPath)) {
+        HILOGE("failed. %{public}s", fullPath.c_str());
+        return false;
+    }
+    ResetAppliedParams_();
+    HILOGI("success. %{public}s", fullPath.c_str());
+    return true;
+}
+
+bool AppMemcg::RemoveMemcgDir()
+{
+    std::string fullPath = GetMemcgPath_();
+    if (!KernelInterface::GetInstance().RemoveDirRecursively(fullPath)) {
+        HILOGE("failed. %{public}s", fullPath.c_str());
+        return false;
+    }
+    HILOGI("success. %{public}s", fullPath.c_str());
+    return true;
+}
+
+std::string AppMemcg::GetMemcgPath_()
+{
+    // app memcg dir: "/dev/memcg/${userId}/${appUid}"
+    return KernelInterface::GetInstance().JoinPath(KernelInterface::MEMCG_BASE_PATH, std::to_string(userId_),
+        std::to_string(appUid_));
+}
+
+bool AppMemcg::AddProc(unsigned int pid)
+{
+    bool ret = AddProcs({ pid }) == 1;
+    HILOGI("add pid=%{public}u to %{public}s %{public}s", pid, GetMemcgPath_().c_str(), ret ? "succ" : "fail");
     return ret;
 }
 } // namespace Memory
@@ -37,6 +37,10 @@ MemcgMgr::~MemcgMgr()
 {
     delete rootMemcg_;
     rootMemcg_ = nullptr;
+    for (auto &pair : appMemcgsMap_) {
+        delete pair.second;
+    }
+    appMemcgsMap_.clear();
     while (!userMemcgsMap_.empty()) {
         auto iter = userMemcgsMap_.begin();
         delete iter->second;
@@ -94,6 +98,7 @@ bool MemcgMgr::RemoveUserMemcg(unsigned int userId)
         HILOGI("account %{public}u not exist. cannot remove", userId);
         return false;
     }
+    RemoveAppMemcgsOfUser(userId); // children first, a memcg with children can not be removed
     memcg->RemoveMemcgDir();
     userMemcgsMap_.erase(userId);
     delete memcg;
@@ -129,6 +134,21 @@ bool MemcgMgr::AddProcToMemcg(unsigned int pid, unsigned int userId)
     return memcg->AddProc(pid); // add pid to memcg
 }
 
+int MemcgMgr::AddProcsToMemcg(const std::vector<unsigned int>& pids, unsigned int userId, bool verify)
+{
+    HILOGI("%{public}zu pids userId=%{public}u", pids.size(), userId);
+    UserMemcg* memcg = GetUserMemcg(userId);
+    if (memcg == nullptr) { // new user
+        HILOGI("no such user. go create %{public}u", userId);
+        memcg = AddUserMemcg(userId);
+    }
+    if (memcg == nullptr) {
+        HILOGE("AddUserMemcg failed %{public}u", userId);
+        return 0;
+    }
+    return memcg->AddProcs(pids, verify);
+}
+
 bool MemcgMgr::SwapInMemcg(unsigned int userId)
 {
     UserMemcg* memcg = GetUserMemcg(userId);
@@ -156,5 +176,133 @@ MemInfo* MemcgMgr::GetMemcgMemInfo(unsigned int userId)
     memcg->UpdateMemInfoFromKernel();
     return memcg->memInfo_;
 }
+
+AppMemcg* MemcgMgr::GetAppMemcg(int appUid)
+{
+    auto it = appMemcgsMap_.find(appUid);
+    if (it == appMemcgsMap_.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+AppMemcg* MemcgMgr::AddAppMemcg(unsigned int userId, int appUid)
+{
+    HILOGI("userId=%{public}u appUid=%{public}d", userId, appUid);
+    AppMemcg* memcg = new (std::nothrow) AppMemcg(userId, appUid);
+    if (memcg == nullptr) {
+        HILOGE("new obj failed!");
+        return nullptr;
+    }
+    if (!memcg->CreateMemcgDir()) {
+        delete memcg;
+        return nullptr;
+    }
+    appMemcgsMap_.insert(std::make_pair(appUid, memcg));
+    return memcg;
+}
+
+bool MemcgMgr::RemoveAppMemcg(int appUid)
+{
+    AppMemcg* memcg = GetAppMemcg(appUid);
+    if (memcg == nullptr) {
+        return false;
+    }
+    HILOGI("appUid=%{public}d", appUid);
+    bool ret = memcg->RemoveMemcgDir();
+    appMemcgsMap_.erase(appUid);
+    delete memcg;
+    return ret;
+}
+
+void MemcgMgr::RemoveAppMemcgsOfUser(unsigned int userId)
+{
+    for (auto it = appMemcgsMap_.begin(); it != appMemcgsMap_.end();) {
+        if (it->second->userId_ != userId) {
+            ++it;
+            continue;
+        }
+        it->second->RemoveMemcgDir();
+        delete it->second;
+        it = appMemcgsMap_.erase(it);
+    }
+}
+
+bool MemcgMgr::AddProcToAppMemcg(unsigned int pid, unsigned int userId, int appUid)
+{
+    HILOGI("pid=%{public}u userId=%{public}u appUid=%{public}d", pid, userId, appUid);
+    UserMemcg* userMemcg = GetUserMemcg(userId);
+    if (userMemcg == nullptr) { // new user
+        userMemcg = AddUserMemcg(userId);
+    }
+    if (userMemcg == nullptr) {
+        HILOGE("AddUserMemcg failed %{public}u", userId);
+        return false;
+    }
+    AppMemcg* memcg = GetAppMemcg(appUid);
+    if (memcg == nullptr) {
+        memcg = AddAppMemcg(userId, appUid);
+    }
+    if (memcg == nullptr) {
+        HILOGI("AddAppMemcg failed %{public}d, add pid to memcg of user", appUid);
+        return userMemcg->AddProc(pid);
+    }
+    return memcg->AddProc(pid);
+}
+
+bool MemcgMgr::UpdateAppMemcgScoreAndReclaimRatios(int appUid, int score, const ReclaimRatios& ratios)
+{
+    AppMemcg* memcg = GetAppMemcg(appUid);
+    if (memcg == nullptr) {
+        HILOGD("app memcg %{public}d not exist. cannot update score and ratios", appUid);
+        return false;
+    }
+    HILOGI("update reclaim ratios appUid=%{public}d score=%{public}d, %{public}s",
+           appUid, score, ratios.ToString().c_str());
+    memcg->SetScore(score);
+    return memcg->SetReclaimRatios(ratios) && memcg->SetScoreAndReclaimRatiosToKernel();
+}
+
+std::vector<unsigned int> MemcgMgr::GetUserIds() const
+{
+    std::vector<unsigned int> userIds;
+    userIds.reserve(userMemcgsMap_.size());
+    for (const auto &pair : userMemcgsMap_) {
+        userIds.push_back(static_cast<unsigned int>(pair.first));
+    }
+    return userIds;
+}
+
+std::vector<int> MemcgMgr::GetAppUids() const
+{
+    std::vector<int> appUids;
+    appUids.reserve(appMemcgsMap_.size());
+    for (const auto &pair : appMemcgsMap_) {
+        appUids.push_back(pair.first);
+    }
+    return appUids;
+}
+
+int MemcgMgr::ReconcileMemcgs()
+{
+    int count = 0;
+    if (rootMemcg_ != nullptr && !rootMemcg_->ReconcileWithKernel()) {
+        count++;
+    }
+    for (const auto &pair : userMemcgsMap_) {
+        if (!pair.second->ReconcileWithKernel()) {
+            count++;
+        }
+    }
+    for (const auto &pair : appMemcgsMap_) {
+        if (!pair.second->ReconcileWithKernel()) {
+            count++;
+        }
+    }
+    if (count > 0) {
+        HILOGI("%{public}d memcgs not matched with kernel", count);
+    }
+    return count;
+}
 } // namespace Memory
 } // namespace OHOS
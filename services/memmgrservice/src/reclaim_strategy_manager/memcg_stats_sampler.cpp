@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memcg_stats_sampler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "memcg_mgr.h"
+#include "memmgr_log.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "MemcgStatsSampler";
+const std::string SAMPLE_TASK_NAME = "MemcgStatsSample";
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// drop samples of memcgs not in ids
+template <typename SampleMap, typename Id>
+void RetainSamples(SampleMap &samples, const std::vector<Id> &ids)
+{
+    for (auto it = samples.begin(); it != samples.end();) {
+        if (std::find(ids.begin(), ids.end(), it->first) == ids.end()) {
+            it = samples.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+} // namespace
+
+IMPLEMENT_SINGLE_INSTANCE(MemcgStatsSampler);
+
+void MemcgStatsSampler::Start(std::shared_ptr<LaneHandler> handler, unsigned int periodMs, unsigned int sampleCount)
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        handler_ = handler;
+        periodMs_ = periodMs;
+        sampleCount_ = std::max(sampleCount, 1u);
+    }
+    if (handler == nullptr || periodMs == 0) {
+        HILOGI("memcg stats sampling disabled");
+        return;
+    }
+    handler->RemoveTask(SAMPLE_TASK_NAME);
+    ScheduleNext();
+    HILOGI("sample memcg stats every %{public}ums, keep %{public}u samples", periodMs, sampleCount);
+}
+
+void MemcgStatsSampler::Stop()
+{
+    std::shared_ptr<LaneHandler> handler;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        handler.swap(handler_);
+        periodMs_ = 0;
+    }
+    if (handler != nullptr) {
+        handler->RemoveTask(SAMPLE_TASK_NAME);
+    }
+}
+
+void MemcgStatsSampler::SetRoundCallback(RoundCallback callback)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    roundCallback_ = std::move(callback);
+}
+
+void MemcgStatsSampler::ScheduleNext()
+{
+    std::shared_ptr<LaneHandler> handler;
+    unsigned int periodMs = 0;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        handler = handler_;
+        periodMs = periodMs_;
+    }
+    if (handler == nullptr || periodMs == 0) {
+        return;
+    }
+    handler->PostTask([this] {
+        SampleAll();
+        ScheduleNext();
+    }, SAMPLE_TASK_NAME, periodMs, AppExecFwk::EventQueue::Priority::LOW);
+}
+
+void MemcgStatsSampler::SampleAll()
+{
+    std::vector<unsigned int> userIds = MemcgMgr::GetInstance().GetUserIds();
+    RetainMemcgs(userIds);
+    int64_t nowMs = GetSteadyTimeMs();
+    for (unsigned int userId : userIds) {
+        UserMemcg *memcg = MemcgMgr::GetInstance().GetUserMemcg(userId);
+        MemcgStat stat;
+        if (memcg == nullptr || !memcg->ReadMemcgStat(stat)) {
+            continue;
+        }
+        AddSample(userId, nowMs, stat);
+    }
+    // app processes are charged to app memcgs, not to the user memcg locally
+    std::vector<int> appUids = MemcgMgr::GetInstance().GetAppUids();
+    RetainAppMemcgs(appUids);
+    for (int appUid : appUids) {
+        AppMemcg *memcg = MemcgMgr::GetInstance().GetAppMemcg(appUid);
+        MemcgStat stat;
+        if (memcg == nullptr || !memcg->ReadMemcgStat(stat)) {
+            continue;
+        }
+        AddAppSample(appUid, nowMs, stat);
+    }
+    RoundCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        roundCount_++;
+        callback = roundCallback_;
+    }
+    if (callback) {
+        callback(userIds, appUids);
+    }
+}
+
+void MemcgStatsSampler::RetainMemcgs(const std::vector<unsigned int> &userIds)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    RetainSamples(samples_, userIds);
+}
+
+void MemcgStatsSampler::RetainAppMemcgs(const std::vector<int> &appUids)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    RetainSamples(appSamples_, appUids);
+}
+
+void MemcgStatsSampler::AddSample(unsigned int userId, int64_t timeMs, const MemcgStat &stat)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    AppendSampleLocked(samples_[userId], timeMs, stat);
+}
+
+void MemcgStatsSampler::AddAppSample(int appUid, int64_t timeMs, const MemcgStat &stat)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    AppendSampleLocked(appSamples_[appUid], timeMs, stat);
+}
+
+void MemcgStatsSampler::AppendSampleLocked(std::deque<MemcgStatsSample> &samples, int64_t timeMs,
+    const MemcgStat &stat)
+{
+    MemcgStatsSample sample;
+    sample.timeMs = timeMs;
+    sample.stat = stat;
+    if (!samples.empty()) {
+        const MemcgStat &last = samples.back().stat;
+        sample.anonDeltaKiB = stat.anonKiB - last.anonKiB;
+        sample.zramDeltaKiB = stat.zramKiB - last.zramKiB;
+        sample.eswapDeltaKiB = stat.eswapKiB - last.eswapKiB;
+        // refaults only grow, a smaller one means the memcg is recreated
+        sample.refaultDelta = std::max(stat.refaults - last.refaults, 0LL);
+    }
+    samples.push_back(sample);
+    while (samples.size() > sampleCount_) {
+        samples.pop_front();
+    }
+}
+
+bool MemcgStatsSampler::GetLatestSample(unsigned int userId, MemcgStatsSample &sample)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = samples_.find(userId);
+    if (it == samples_.end() || it->second.empty()) {
+        return false;
+    }
+    sample = it->second.back();
+    return true;
+}
+
+std::vector<MemcgStatsSample> MemcgStatsSampler::GetSamples(unsigned int userId)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = samples_.find(userId);
+    if (it == samples_.end()) {
+        return {};
+    }
+    return std::vector<MemcgStatsSample>(it->second.begin(), it->second.end());
+}
+
+std::vector<MemcgStatsSample> MemcgStatsSampler::GetAppSamples(int appUid)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = appSamples_.find(appUid);
+    if (it == appSamples_.end()) {
+        return {};
+    }
+    return std::vector<MemcgStatsSample>(it->second.begin(), it->second.end());
+}
+
+void MemcgStatsSampler::Dump(int fd)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    dprintf(fd, "memcg stats: period %ums, keep %u samples, %llu rounds, %zu app memcgs\n", periodMs_,
+        sampleCount_, static_cast<unsigned long long>(roundCount_), appSamples_.size());
+    dprintf(fd, "  userId   anonKiB   zramKiB  eswapKiB  refaults | in window: anon  zram  eswap  refaults\n");
+    for (const auto &pair : samples_) {
+        if (pair.second.empty()) {
+            continue;
+        }
+        const MemcgStat &stat = pair.second.back().stat;
+        long long anonDelta = 0;
+        long long zramDelta = 0;
+        long long eswapDelta = 0;
+        long long refaultDelta = 0;
+        for (const auto &sample : pair.second) {
+            anonDelta += sample.anonDeltaKiB;
+            zramDelta += sample.zramDeltaKiB;
+            eswapDelta += sample.eswapDeltaKiB;
+            refaultDelta += sample.refaultDelta;
+        }
+        dprintf(fd, "%8u %9lld %9lld %9lld %9lld | %lld %lld %lld %lld\n", pair.first, stat.anonKiB, stat.zramKiB,
+            stat.eswapKiB, stat.refaults, anonDelta, zramDelta, eswapDelta, refaultDelta);
+    }
+}
+} // namespace Memory
+} // namespace OHOS
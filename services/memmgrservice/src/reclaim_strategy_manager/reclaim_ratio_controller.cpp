@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "reclaim_ratio_controller.h"
+
+#include <algorithm>
+
+#include "memcg_mgr.h"
+#include "memmgr_log.h"
+#include "reclaim_strategy_constants.h"
+
+namespace OHOS {
+namespace Memory {
+namespace {
+const std::string TAG = "ReclaimRatioController";
+const long long MS_PER_SECOND = 1000;
+
+// forget states of memcgs not in ids
+template <typename StateMap, typename Id>
+void RetainStates(StateMap &states, const std::vector<Id> &ids)
+{
+    for (auto it = states.begin(); it != states.end();) {
+        if (std::find(ids.begin(), ids.end(), it->first) == ids.end()) {
+            it = states.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+} // namespace
+
+IMPLEMENT_SINGLE_INSTANCE(ReclaimRatioController);
+
+void ReclaimRatioController::Init(const RatioControllerConfig &config)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    config_ = config;
+    HILOGI("max offset %{public}u, step %{public}u, refaults per second %{public}u-%{public}u",
+        config.maxOffset, config.step, config.refaultLow, config.refaultHigh);
+}
+
+unsigned int ReclaimRatioController::ApplyOffset(unsigned int ratio, int offset)
+{
+    int value = static_cast<int>(ratio) + offset;
+    return static_cast<unsigned int>(std::clamp(value, 0, PERCENT_100));
+}
+
+void ReclaimRatioController::SetBaseRatios(unsigned int userId, ReclaimRatios &ratios)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    SetBaseRatiosOfState(states_[userId], ratios);
+}
+
+void ReclaimRatioController::SetAppBaseRatios(int appUid, ReclaimRatios &ratios)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    SetBaseRatiosOfState(appStates_[appUid], ratios);
+}
+
+void ReclaimRatioController::SetBaseRatiosOfState(MemcgState &state, ReclaimRatios &ratios)
+{
+    state.mem2zramRatio = ratios.mem2zramRatio_;
+    state.zram2ufsRatio = ratios.zram2ufsRatio_;
+    state.refaultThreshold = ratios.refaultThreshold_;
+    ratios.SetRatiosByValue(ApplyOffset(state.mem2zramRatio, state.offset),
+        ApplyOffset(state.zram2ufsRatio, state.offset), state.refaultThreshold);
+}
+
+int ReclaimRatioController::NextOffset(int offset, long long refaultsPerSec, const MemcgStat &stat,
+    const RatioControllerConfig &config)
+{
+    if (!stat.refaultsValid) {
+        // kernel does not count refaults of memcg, nothing tells whether compressed pages are hot
+        return 0;
+    }
+    int maxOffset = static_cast<int>(config.maxOffset);
+    int step = static_cast<int>(config.step);
+    if (refaultsPerSec > static_cast<long long>(config.refaultHigh)) {
+        // thrashing, compressed pages are hot
+        offset -= step;
+    } else if (refaultsPerSec < static_cast<long long>(config.refaultLow) && stat.anonKiB > 0 &&
+        stat.zramKiB + stat.eswapKiB > 0) {
+        // compressed pages are cold, more of anon can follow them
+        offset += step;
+    }
+    return std::clamp(offset, -maxOffset, maxOffset);
+}
+
+ReclaimRatioController::MemcgState ReclaimRatioController::MakeState(const ReclaimRatios &ratios)
+{
+    // priority of the memcg is not notified yet, ratios in use are the base
+    MemcgState state;
+    state.mem2zramRatio = ratios.mem2zramRatio_;
+    state.zram2ufsRatio = ratios.zram2ufsRatio_;
+    state.refaultThreshold = ratios.refaultThreshold_;
+    return state;
+}
+
+bool ReclaimRatioController::AdjustOffset(MemcgState &state, const std::vector<MemcgStatsSample> &samples)
+{
+    const MemcgStatsSample &latest = samples.back();
+    int64_t intervalMs = latest.timeMs - samples[samples.size() - 2].timeMs; // 2: the previous sample
+    if (intervalMs <= 0) {
+        return false;
+    }
+    state.refaultsPerSec = latest.refaultDelta * MS_PER_SECOND / intervalMs;
+    int offset = NextOffset(state.offset, state.refaultsPerSec, latest.stat, config_);
+    if (offset == state.offset) {
+        return false;
+    }
+    state.offset = offset;
+    state.adjustCount++;
+    return true;
+}
+
+void ReclaimRatioController::Update(const std::vector<unsigned int> &userIds, const std::vector<int> &appUids)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    RetainStates(states_, userIds);
+    RetainStates(appStates_, appUids);
+    if (config_.maxOffset == 0) {
+        return;
+    }
+    for (unsigned int userId : userIds) {
+        std::vector<MemcgStatsSample> samples = MemcgStatsSampler::GetInstance().GetSamples(userId);
+        UserMemcg *memcg = MemcgMgr::GetInstance().GetUserMemcg(userId);
+        if (samples.size() < 2 || memcg == nullptr || memcg->reclaimRatios_ == nullptr) { // 2: rate needs two
+            continue;
+        }
+        auto stateIt = states_.find(userId);
+        if (stateIt == states_.end()) {
+            stateIt = states_.emplace(userId, MakeState(*memcg->reclaimRatios_)).first;
+        }
+        MemcgState &state = stateIt->second;
+        if (!AdjustOffset(state, samples)) {
+            continue;
+        }
+        HILOGI("userId=%{public}u refaults=%{public}lld/s, offset -> %{public}d", userId,
+            state.refaultsPerSec, state.offset);
+        ReclaimRatios ratios(ApplyOffset(state.mem2zramRatio, state.offset),
+            ApplyOffset(state.zram2ufsRatio, state.offset), state.refaultThreshold);
+        MemcgMgr::GetInstance().UpdateMemcgScoreAndReclaimRatios(userId, memcg->score_, ratios);
+    }
+    // processes of apps are in app memcgs, which the user memcgs above do not count locally
+    for (int appUid : appUids) {
+        std::vector<MemcgStatsSample> samples = MemcgStatsSampler::GetInstance().GetAppSamples(appUid);
+        AppMemcg *memcg = MemcgMgr::GetInstance().GetAppMemcg(appUid);
+        if (samples.size() < 2 || memcg == nullptr || memcg->reclaimRatios_ == nullptr) { // 2: rate needs two
+            continue;
+        }
+        auto stateIt = appStates_.find(appUid);
+        if (stateIt == appStates_.end()) {
+            stateIt = appStates_.emplace(appUid, MakeState(*memcg->reclaimRatios_)).first;
+        }
+        MemcgState &state = stateIt->second;
+        if (!AdjustOffset(state, samples)) {
+            continue;
+        }
+        HILOGD("appUid=%{public}d refaults=%{public}lld/s, offset -> %{public}d", appUid,
+            state.refaultsPerSec, state.offset);
+        ReclaimRatios ratios(ApplyOffset(state.mem2zramRatio, state.offset),
+            ApplyOffset(state.zram2ufsRatio, state.offset), state.refaultThreshold);
+        MemcgMgr::GetInstance().UpdateAppMemcgScoreAndReclaimRatios(appUid, memcg->score_, ratios);
+    }
+}
+
+int ReclaimRatioController::GetOffset(unsigned int userId)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = states_.find(userId);
+    return it == states_.end() ? 0 : it->second.offset;
+}
+
+int ReclaimRatioController::GetAppOffset(int appUid)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = appStates_.find(appUid);
+    return it == appStates_.end() ? 0 : it->second.offset;
+}
+
+void ReclaimRatioController::Dump(int fd)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    dprintf(fd, "reclaim ratio controller: max offset %u, step %u\n", config_.maxOffset, config_.step);
+    dprintf(fd, "  userId  base(mem2zram zram2ufs)  offset  refaults/s  adjusted\n");
+    for (const auto &pair : states_) {
+        const MemcgState &state = pair.second;
+        dprintf(fd, "%8u %13u %8u %9d %11lld %9llu\n", pair.first, state.mem2zramRatio, state.zram2ufsRatio,
+            state.offset, state.refaultsPerSec, static_cast<unsigned long long>(state.adjustCount));
+    }
+    dprintf(fd, "  appUid  base(mem2zram zram2ufs)  offset  refaults/s  adjusted\n");
+    for (const auto &pair : appStates_) {
+        const MemcgState &state = pair.second;
+        dprintf(fd, "%8d %13u %8u %9d %11lld %9llu\n", pair.first, state.mem2zramRatio, state.zram2ufsRatio,
+            state.offset, state.refaultsPerSec, static_cast<unsigned long long>(state.adjustCount));
+    }
+}
+} // namespace Memory
+} // namespace OHOS
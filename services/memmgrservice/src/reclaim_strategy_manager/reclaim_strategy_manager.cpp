@@ -13,12 +13,15 @@
  * limitations under the License.
  */
 
+#include <map>
 
 #include "avail_buffer_manager.h"
+#include "memcg_stats_sampler.h"
 #include "memmgr_config_manager.h"
 #include "memmgr_log.h"
 #include "memmgr_ptr_util.h"
 #include "reclaim_priority_constants.h"
+#include "reclaim_ratio_controller.h"
 #include "reclaim_strategy_constants.h"
 #include "reclaim_strategy_manager.h"
 
@@ -26,6 +29,7 @@ namespace OHOS {
 namespace Memory {
 namespace {
 const std::string TAG = "ReclaimStrategyManager";
+const std::string MEMCG_RECONCILE_TASK_NAME = "MemcgReconcile";
 }
 
 IMPLEMENT_SINGLE_INSTANCE(ReclaimStrategyManager);
@@ -53,6 +57,15 @@ bool ReclaimStrategyManager::Init()
         return false;
     }
     InitProcessBeforeMemmgr(); // add the process (which started before memmgr) to memcg
+    const ReclaimConfig &reclaimConfig = MemmgrConfigManager::GetInstance().GetReclaimConfig();
+    ReclaimRatioController::GetInstance().Init(reclaimConfig.GetRatioControllerConfig());
+    MemcgStatsSampler::GetInstance().SetRoundCallback([](const std::vector<unsigned int> &userIds,
+        const std::vector<int> &appUids) {
+        ReclaimRatioController::GetInstance().Update(userIds, appUids);
+    });
+    MemcgStatsSampler::GetInstance().Start(handler_, reclaimConfig.GetStatsSamplePeriodMs(),
+        reclaimConfig.GetStatsSampleCount());
+    ScheduleMemcgReconcile_();
     HILOGI("init success");
     return initialized_;
 }
@@ -60,37 +73,45 @@ bool ReclaimStrategyManager::Init()
 bool ReclaimStrategyManager::CreateEventHandler()
 {
     if (handler_ == nullptr) {
-        MAKE_POINTER(handler_, shared, AppExecFwk::EventHandler, "failed to create event handler", return false,
-            AppExecFwk::EventRunner::Create());
+        MAKE_POINTER(handler_, shared, LaneHandler, "failed to create event handler", return false,
+            ExecutorLane::RECLAIM);
     }
     return true;
 }
 
-std::shared_ptr<AppExecFwk::EventHandler> ReclaimStrategyManager::GetEventHandler() const
+void ReclaimStrategyManager::ScheduleMemcgReconcile_()
+{
+    // writes of score and ratios are not read back, kernel values are checked here at a low rate
+    handler_->PostTask([this] {
+        MemcgMgr::GetInstance().ReconcileMemcgs();
+        ScheduleMemcgReconcile_();
+    }, MEMCG_RECONCILE_TASK_NAME, MEMCG_RECONCILE_PERIOD_MS, AppExecFwk::EventQueue::Priority::LOW);
+}
+
+std::shared_ptr<LaneHandler> ReclaimStrategyManager::GetEventHandler() const
 {
     return handler_;
 }
 
 void ReclaimStrategyManager::InitProcessBeforeMemmgr()
 {
-    std::vector<unsigned int> pids;
-    if (!KernelInterface::GetInstance().GetAllProcPids(pids)) {
-        HILOGI("GetAllProcPids failed");
+    std::vector<ProcStatus> procs;
+    if (!KernelInterface::GetInstance().GetAllProcStatus(procs)) {
+        HILOGI("GetAllProcStatus failed");
         return;
     }
-    unsigned int uid =  0;
-    int userId = 0;
-    bool ret = false;
-    for (auto pid : pids) {
-        if (!KernelInterface::GetInstance().GetUidByPid(pid, uid)) {
-            continue;
-        }
-        userId = GetOsAccountIdByUid(static_cast<int>(uid));
+    // pids of a user are moved in one batch, so that cgroup.procs is opened and checked once per user
+    std::map<unsigned int, std::vector<unsigned int>> userPids; // map<userId, pids>
+    for (const auto &proc : procs) {
+        int userId = GetOsAccountIdByUid(static_cast<int>(proc.uid));
         if (userId < VALID_USER_ID_MIN) { // invalid userId
             continue;
         }
-        ret = MemcgMgr::GetInstance().AddProcToMemcg(pid, userId);
-        HILOGD("add pid=%{public}u to userId=%{public}u, %{public}s", pid, userId, ret ? "succ" : "fail");
+        userPids[static_cast<unsigned int>(userId)].push_back(static_cast<unsigned int>(proc.pid));
+    }
+    for (const auto &pair : userPids) {
+        int added = MemcgMgr::GetInstance().AddProcsToMemcg(pair.second, pair.first, true);
+        HILOGI("add %{public}d of %{public}zu pids to userId=%{public}u", added, pair.second.size(), pair.first);
     }
 }
 
@@ -119,14 +140,18 @@ bool ReclaimStrategyManager::HandleAppStateChanged_(std::shared_ptr<ReclaimParam
     switch (reclaimPara->action_) {
         case AppAction::CREATE_PROCESS_AND_APP:
         case AppAction::CREATE_PROCESS_ONLY: {
-            HandleProcessCreate_(reclaimPara);
+            ret = HandleProcessCreate_(reclaimPara);
+            HandleAppPriorityChanged_(reclaimPara);
+            break;
+        }
+        case AppAction::APP_DIED: {
+            ret = MemcgMgr::GetInstance().RemoveAppMemcg(reclaimPara->bundleUid_);
             break;
         }
-        case AppAction::APP_DIED:
         case AppAction::APP_FOREGROUND:
         case AppAction::APP_BACKGROUND:
         case AppAction::OTHERS: {
-            HILOGI("others app action! %{public}s", ReclaimParam::GetAppActionStr(reclaimPara->action_).c_str());
+            ret = HandleAppPriorityChanged_(reclaimPara);
             break;
         }
         default:
@@ -138,11 +163,28 @@ bool ReclaimStrategyManager::HandleAppStateChanged_(std::shared_ptr<ReclaimParam
 
 bool ReclaimStrategyManager::HandleProcessCreate_(std::shared_ptr<ReclaimParam> reclaimPara)
 {
-    bool ret = MemcgMgr::GetInstance().AddProcToMemcg(reclaimPara->pid_, reclaimPara->accountId_);
+    bool ret = MemcgMgr::GetInstance().AddProcToAppMemcg(reclaimPara->pid_, reclaimPara->accountId_,
+        reclaimPara->bundleUid_);
     HILOGI("%{public}s, %{public}s", ret ? "succ" : "fail",  reclaimPara->ToString().c_str());
     return ret;
 }
 
+bool ReclaimStrategyManager::HandleAppPriorityChanged_(std::shared_ptr<ReclaimParam> reclaimPara)
+{
+    if (MemcgMgr::GetInstance().GetAppMemcg(reclaimPara->bundleUid_) == nullptr) {
+        return false;
+    }
+    int score = reclaimPara->score_;
+    GetValidScore_(score);
+    ReclaimRatios ratios;
+    if (!GetReclaimRatiosByScore_(score, ratios)) {
+        HILOGE("get config ratios failed, will not update memcg ratio, appUid=%{public}d", reclaimPara->bundleUid_);
+        return false;
+    }
+    ReclaimRatioController::GetInstance().SetAppBaseRatios(reclaimPara->bundleUid_, ratios);
+    return MemcgMgr::GetInstance().UpdateAppMemcgScoreAndReclaimRatios(reclaimPara->bundleUid_, score, ratios);
+}
+
 void ReclaimStrategyManager::NotifyAccountDied(int accountId)
 {
     if (!Initailized()) {
@@ -197,6 +239,7 @@ bool ReclaimStrategyManager::HandleAccountPriorityChanged_(int accountId, int pr
         ratios = nullptr;
         return false;
     }
+    ReclaimRatioController::GetInstance().SetBaseRatios(accountId, *ratios);
     bool ret = MemcgMgr::GetInstance().UpdateMemcgScoreAndReclaimRatios(accountId, priority, *ratios);
     HILOGI("UpdateMemcgScoreAndReclaimRatios %{public}s, userId=%{public}d score=%{public}d %{public}s",
            ret ? "succ" : "fail", accountId, priority, ratios->ToString().c_str());
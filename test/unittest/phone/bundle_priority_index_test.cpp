@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "bundle_priority_index.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+class BundlePriorityIndexTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void BundlePriorityIndexTest::SetUpTestCase()
+{
+}
+
+void BundlePriorityIndexTest::TearDownTestCase()
+{
+}
+
+void BundlePriorityIndexTest::SetUp()
+{
+}
+
+void BundlePriorityIndexTest::TearDown()
+{
+}
+
+static std::shared_ptr<BundlePriorityInfo> NewBundle(int uid, int priority)
+{
+    return std::make_shared<BundlePriorityInfo>("app" + std::to_string(uid), uid, priority);
+}
+
+HWTEST_F(BundlePriorityIndexTest, InsertAndEraseTest, TestSize.Level1)
+{
+    BundlePriorityIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.begin(), index.end());
+    EXPECT_EQ(index.rbegin(), index.rend());
+
+    auto bundle1 = NewBundle(20010001, 100);
+    auto bundle2 = NewBundle(20010002, 100);
+    EXPECT_TRUE(index.insert(bundle1).second);
+    EXPECT_TRUE(index.insert(bundle2).second);
+    // unique by uid
+    EXPECT_FALSE(index.insert(NewBundle(20010001, 200)).second);
+    EXPECT_FALSE(index.insert(nullptr).second);
+    EXPECT_EQ(index.size(), 2);
+    EXPECT_TRUE(index.Contains(20010001));
+
+    EXPECT_EQ(index.erase(bundle1), 1);
+    EXPECT_EQ(index.erase(bundle1), 0);
+    EXPECT_FALSE(index.Contains(20010001));
+    EXPECT_EQ(index.size(), 1);
+    index.clear();
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.begin(), index.end());
+}
+
+HWTEST_F(BundlePriorityIndexTest, IterateOrderTest, TestSize.Level1)
+{
+    BundlePriorityIndex index;
+    index.insert(NewBundle(1, RECLAIM_PRIORITY_BACKGROUND));
+    index.insert(NewBundle(2, RECLAIM_PRIORITY_MIN));
+    index.insert(NewBundle(3, RECLAIM_PRIORITY_MAX));
+    index.insert(NewBundle(4, RECLAIM_PRIORITY_BACKGROUND));
+    index.insert(NewBundle(5, RECLAIM_PRIORITY_FOREGROUND));
+
+    std::vector<int> ascending;
+    for (auto bundle : index) {
+        ascending.push_back(bundle->uid_);
+    }
+    std::vector<int> expectAscending = { 2, 5, 4, 1, 3 };
+    EXPECT_EQ(ascending, expectAscending);
+
+    // reverse iterating visits the least recently moved bundle first in the same priority
+    std::vector<int> descending;
+    for (auto itr = index.rbegin(); itr != index.rend(); ++itr) {
+        descending.push_back((*itr)->uid_);
+    }
+    std::vector<int> expectDescending = { 3, 1, 4, 5, 2 };
+    EXPECT_EQ(descending, expectDescending);
+}
+
+HWTEST_F(BundlePriorityIndexTest, UpdateTest, TestSize.Level1)
+{
+    BundlePriorityIndex index;
+    auto bundle1 = NewBundle(1, RECLAIM_PRIORITY_BACKGROUND);
+    auto bundle2 = NewBundle(2, RECLAIM_PRIORITY_FOREGROUND);
+    index.insert(bundle1);
+    index.insert(bundle2);
+    EXPECT_EQ(*index.rbegin(), bundle1);
+
+    bundle2->priority_ = RECLAIM_PRIORITY_EMPTY;
+    EXPECT_TRUE(index.Update(bundle2));
+    EXPECT_EQ(*index.rbegin(), bundle2);
+    EXPECT_EQ(*index.begin(), bundle1);
+    EXPECT_FALSE(index.Update(NewBundle(3, RECLAIM_PRIORITY_EMPTY)));
+
+    // priority out of range is put in the bucket of the bound
+    bundle1->priority_ = RECLAIM_PRIORITY_MAX + 1;
+    EXPECT_TRUE(index.Update(bundle1));
+    EXPECT_EQ(*index.rbegin(), bundle1);
+}
+
+HWTEST_F(BundlePriorityIndexTest, EraseByIteratorTest, TestSize.Level1)
+{
+    BundlePriorityIndex index;
+    for (int uid = 1; uid <= 10; uid++) {
+        index.insert(NewBundle(uid, uid * 100 - RECLAIM_PRIORITY_MAX));
+    }
+    for (auto itr = index.begin(); itr != index.end();) {
+        if ((*itr)->uid_ % 2 == 0) {
+            itr = index.erase(itr);
+            continue;
+        }
+        ++itr;
+    }
+    EXPECT_EQ(index.size(), 5);
+    for (auto bundle : index) {
+        EXPECT_EQ(bundle->uid_ % 2, 1);
+    }
+}
+} // namespace Memory
+} // namespace OHOS
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <vector>
+
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "epoll_reactor.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+namespace {
+void ConsumeEventFd(int fd)
+{
+    uint64_t value = 0;
+    read(fd, &value, sizeof(value));
+}
+
+void SignalEventFd(int fd)
+{
+    uint64_t value = 1;
+    write(fd, &value, sizeof(value));
+}
+}
+
+class EpollReactorTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void EpollReactorTest::SetUpTestCase()
+{
+}
+
+void EpollReactorTest::TearDownTestCase()
+{
+}
+
+void EpollReactorTest::SetUp()
+{
+}
+
+void EpollReactorTest::TearDown()
+{
+}
+
+HWTEST_F(EpollReactorTest, AddRemoveFdTest, TestSize.Level1)
+{
+    int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ASSERT_GE(fd, 0);
+    auto handler = [](int fd, uint32_t events) { ConsumeEventFd(fd); };
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(-1, EPOLLIN, ReactorPriority::NORMAL, "invalid", handler), false);
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(fd, EPOLLIN, ReactorPriority::NORMAL, "nullHandler", nullptr), false);
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(fd, EPOLLIN, ReactorPriority::NORMAL, "AddRemoveFdTest", handler),
+        true);
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(fd, EPOLLIN, ReactorPriority::NORMAL, "AddRemoveFdTest", handler),
+        false);
+    EXPECT_EQ(EpollReactor::GetInstance().IsWatching(fd), true);
+    EXPECT_EQ(EpollReactor::GetInstance().RemoveFd(fd), true);
+    EXPECT_EQ(EpollReactor::GetInstance().RemoveFd(fd), false);
+    EXPECT_EQ(EpollReactor::GetInstance().IsWatching(fd), false);
+    close(fd);
+}
+
+HWTEST_F(EpollReactorTest, DispatchTest, TestSize.Level1)
+{
+    int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ASSERT_GE(fd, 0);
+    std::atomic<int> dispatched {0};
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(fd, EPOLLIN, ReactorPriority::NORMAL, "DispatchTest",
+        [&dispatched](int fd, uint32_t events) {
+            ConsumeEventFd(fd);
+            dispatched++;
+        }), true);
+    SignalEventFd(fd);
+    usleep(100 * 1000); // 100ms: wait for dispatching
+    EXPECT_EQ(dispatched.load(), 1);
+    SignalEventFd(fd);
+    usleep(100 * 1000); // 100ms: wait for dispatching
+    EXPECT_EQ(dispatched.load(), 2); // 2: dispatched again
+    EXPECT_EQ(EpollReactor::GetInstance().RemoveFd(fd), true);
+    SignalEventFd(fd);
+    usleep(100 * 1000); // 100ms: nothing should be dispatched
+    EXPECT_EQ(dispatched.load(), 2); // 2: not dispatched after removed
+    close(fd);
+}
+
+/**
+ * @tc.name: PriorityOrderTest
+ * @tc.desc: Test fds ready in the same wakeup are dispatched by priority
+ * @tc.type: FUNC
+ */
+HWTEST_F(EpollReactorTest, PriorityOrderTest, TestSize.Level1)
+{
+    int blockFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    int normalFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    int urgentFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ASSERT_GE(blockFd, 0);
+    ASSERT_GE(normalFd, 0);
+    ASSERT_GE(urgentFd, 0);
+    std::mutex orderLock;
+    std::vector<int> order;
+    auto record = [&orderLock, &order](int fd, uint32_t events) {
+        ConsumeEventFd(fd);
+        std::lock_guard<std::mutex> lock(orderLock);
+        order.push_back(fd);
+    };
+    // block the reactor thread, so that both fds below are ready in the next wakeup
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(blockFd, EPOLLIN, ReactorPriority::NORMAL, "block",
+        [](int fd, uint32_t events) {
+            ConsumeEventFd(fd);
+            usleep(100 * 1000); // 100ms: block the reactor thread
+        }), true);
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(normalFd, EPOLLIN, ReactorPriority::NORMAL, "normal", record), true);
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(urgentFd, EPOLLIN, ReactorPriority::URGENT, "urgent", record), true);
+    SignalEventFd(blockFd);
+    usleep(20 * 1000); // 20ms: wait for the block handler to run
+    SignalEventFd(normalFd);
+    SignalEventFd(urgentFd);
+    usleep(300 * 1000); // 300ms: wait for dispatching
+
+    {
+        std::lock_guard<std::mutex> lock(orderLock);
+        ASSERT_EQ(order.size(), 2u);
+        EXPECT_EQ(order[0], urgentFd);
+        EXPECT_EQ(order[1], normalFd);
+    }
+    EpollReactor::GetInstance().RemoveFd(blockFd);
+    EpollReactor::GetInstance().RemoveFd(normalFd);
+    EpollReactor::GetInstance().RemoveFd(urgentFd);
+    close(blockFd);
+    close(normalFd);
+    close(urgentFd);
+}
+
+HWTEST_F(EpollReactorTest, RemovedInBatchTest, TestSize.Level1)
+{
+    int urgentFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    int normalFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ASSERT_GE(urgentFd, 0);
+    ASSERT_GE(normalFd, 0);
+    std::atomic<int> normalDispatched {0};
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(normalFd, EPOLLIN, ReactorPriority::NORMAL, "normal",
+        [&normalDispatched](int fd, uint32_t events) { normalDispatched++; }), true);
+    // the urgent handler removes the normal watcher, which is ready in the same batch
+    EXPECT_EQ(EpollReactor::GetInstance().AddFd(urgentFd, EPOLLIN, ReactorPriority::URGENT, "urgent",
+        [normalFd](int fd, uint32_t events) { EpollReactor::GetInstance().RemoveFd(normalFd); }), true);
+    struct epoll_event events[2]; // 2: both fds are ready
+    events[0].events = EPOLLIN;
+    events[0].data.u64 = EpollReactor::GetInstance().fdToId_[normalFd];
+    events[1].events = EPOLLIN;
+    events[1].data.u64 = EpollReactor::GetInstance().fdToId_[urgentFd];
+    EpollReactor::GetInstance().DispatchEvents(events, 2); // 2: both fds are ready
+    EXPECT_EQ(normalDispatched.load(), 0);
+    EXPECT_EQ(EpollReactor::GetInstance().IsWatching(normalFd), false);
+    EpollReactor::GetInstance().RemoveFd(urgentFd);
+    close(urgentFd);
+    close(normalFd);
+}
+}
+}
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <unistd.h>
+
 #include "gtest/gtest.h"
 #include "utils.h"
 
@@ -374,5 +376,98 @@ HWTEST_F(KernelInterfaceTest, SplitOneLineByBlankTest, TestSize.Level1)
     EXPECT_EQ(res[1], std::string("0"));
     EXPECT_EQ(res[2], std::string("kB"));
 }
+
+HWTEST_F(KernelInterfaceTest, KvFileReaderParseValuesTest, TestSize.Level1)
+{
+    const char *content = "MemTotal:        5868304 kB\nMemFree:          226392 kB\n"
+        "MemAvailable:    2390160 kB\nbuffer_size:1200\nanon 4096\nneg:-5\n";
+    const char *keys[] = { "MemAvailable", "buffer_size", "anon", "neg", "Mem", "NotExist" };
+    long long values[6] = { 0 };
+    int found = KvFileReader::ParseValues(content, strlen(content), keys, values, 6);
+    EXPECT_EQ(found, 4);
+    EXPECT_EQ(values[0], 2390160);
+    EXPECT_EQ(values[1], 1200);
+    EXPECT_EQ(values[2], 4096);
+    EXPECT_EQ(values[3], -5);
+    EXPECT_EQ(values[4], 0);
+    EXPECT_EQ(values[5], 0);
+}
+
+HWTEST_F(KernelInterfaceTest, KvFileReaderReadValuesTest, TestSize.Level1)
+{
+    KvFileReader reader(KernelInterface::MEMINFO_PATH);
+    const char *keys[] = { "MemTotal", "MemFree" };
+    long long values[2] = { 0 };
+    EXPECT_EQ(reader.ReadValues(keys, values, 2), 2);
+    EXPECT_GT(values[0], 0);
+    EXPECT_EQ(reader.ReadValues(keys, values, 2), 2);
+
+    KvFileReader invalidReader("/proc/not_exist_file");
+    EXPECT_EQ(invalidReader.ReadValues(keys, values, 2), -1);
+}
+
+HWTEST_F(KernelInterfaceTest, GetProcStatusByPidTest, TestSize.Level1)
+{
+    unsigned int pid = static_cast<unsigned int>(getpid());
+    ProcStatus status;
+    EXPECT_TRUE(KernelInterface::GetInstance().GetProcStatusByPid(pid, status));
+    EXPECT_EQ(status.pid, pid);
+    EXPECT_EQ(status.tgid, pid);
+    EXPECT_EQ(status.uid, static_cast<unsigned int>(getuid()));
+    EXPECT_FALSE(status.name.empty());
+
+    unsigned int uid = 0;
+    EXPECT_TRUE(KernelInterface::GetInstance().GetUidByPid(pid, uid));
+    EXPECT_EQ(uid, status.uid);
+    EXPECT_FALSE(KernelInterface::GetInstance().GetProcStatusByPid(0, status));
+}
+
+HWTEST_F(KernelInterfaceTest, GetAllProcStatusTest, TestSize.Level1)
+{
+    std::vector<ProcStatus> statusList;
+    EXPECT_TRUE(KernelInterface::GetInstance().GetAllProcStatus(statusList));
+    unsigned int pid = static_cast<unsigned int>(getpid());
+    bool foundSelf = false;
+    for (const auto &status : statusList) {
+        if (status.pid == pid) {
+            foundSelf = true;
+            break;
+        }
+    }
+    EXPECT_TRUE(foundSelf);
+}
+
+HWTEST_F(KernelInterfaceTest, BatchWriteTest, TestSize.Level1)
+{
+    const std::string BASE_PATH = "/data/local/tmp";
+    std::string pathA = KernelInterface::GetInstance().JoinPath(BASE_PATH, "batchFileA");
+    std::string pathB = KernelInterface::GetInstance().JoinPath(BASE_PATH, "batchFileB");
+    EXPECT_EQ(KernelInterface::GetInstance().CreateFile(pathA), true);
+    EXPECT_EQ(KernelInterface::GetInstance().CreateFile(pathB), true);
+    int fdB = open(pathB.c_str(), O_WRONLY | O_CLOEXEC);
+    EXPECT_GE(fdB, 0);
+
+    std::vector<BatchWriteEntry> entries(3); // 3: by path, by fd and an invalid one
+    entries[0].path = pathA;
+    entries[0].content = "100";
+    entries[1].fd = fdB;
+    entries[1].content = "-900";
+    entries[2].path = KernelInterface::GetInstance().JoinPath(BASE_PATH, "notExistDir/batchFile");
+    entries[2].content = "0";
+    EXPECT_EQ(KernelInterface::GetInstance().BatchWrite(entries), 2); // 2: entries written
+    EXPECT_EQ(entries[0].error, 0);
+    EXPECT_EQ(entries[1].error, 0);
+    EXPECT_EQ(entries[2].error, ENOENT);
+
+    std::string output;
+    EXPECT_EQ(KernelInterface::GetInstance().ReadFromFile(pathA, output), true);
+    EXPECT_EQ(output, "100");
+    EXPECT_EQ(KernelInterface::GetInstance().ReadFromFile(pathB, output), true);
+    EXPECT_EQ(output, "-900");
+    EXPECT_EQ(fcntl(fdB, F_GETFD) >= 0, true); // fd of caller is not closed
+    close(fdB);
+    KernelInterface::GetInstance().RemoveFile(pathA);
+    KernelInterface::GetInstance().RemoveFile(pathB);
+}
 } //namespace Memory
 } //namespace OHOS
@@ -15,11 +15,19 @@
 
 #include "gtest/gtest.h"
 
+#include <csignal>
+#include <future>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
 #include "utils.h"
 
 #define private public
 #define protected public
 #include "low_memory_killer.h"
+#include "process_handle_table.h"
+#include "reclaim_priority_manager.h"
 #include "reclaim_strategy_manager.h"
 #undef private
 #undef protected
@@ -86,6 +94,101 @@ HWTEST_F(LowMemoryKillerTest, KillOneBundleByPrioTest, TestSize.Level1)
     MemcgMgr::GetInstance().RemoveUserMemcg(userId);
 }
 
+static pid_t ForkSleepingChild()
+{
+    pid_t pid = fork();
+    if (pid == 0) {
+        for (;;) {
+            pause();
+        }
+    }
+    return pid;
+}
+
+/**
+ * @tc.name: KillWithStaleSnapshotTest
+ * @tc.desc: Test a bundle killed earlier in the same event is not picked again, even if
+ *           the snapshot can not be rebuilt because the set is held by others
+ * @tc.type: FUNC
+ */
+HWTEST_F(LowMemoryKillerTest, KillWithStaleSnapshotTest, TestSize.Level1)
+{
+    ReclaimPriorityManager &manager = ReclaimPriorityManager::GetInstance();
+    int accountId = 234;
+    pid_t pid1 = ForkSleepingChild();
+    pid_t pid2 = ForkSleepingChild();
+    ASSERT_GT(pid1, 0);
+    ASSERT_GT(pid2, 0);
+    std::shared_ptr<AccountBundleInfo> account = std::make_shared<AccountBundleInfo>(accountId);
+    std::shared_ptr<BundlePriorityInfo> bundle1 = std::make_shared<BundlePriorityInfo>("com.test.lmk1",
+        accountId * USER_ID_SHIFT + 1, RECLAIM_PRIORITY_MAX, accountId, BundleState::STATE_DEFAULT);
+    std::shared_ptr<BundlePriorityInfo> bundle2 = std::make_shared<BundlePriorityInfo>("com.test.lmk2",
+        accountId * USER_ID_SHIFT + 2, RECLAIM_PRIORITY_MAX - 1, accountId, BundleState::STATE_DEFAULT);
+    ProcessPriorityInfo proc1(pid1, bundle1->uid_, bundle1->priority_);
+    ProcessPriorityInfo proc2(pid2, bundle2->uid_, bundle2->priority_);
+    bundle1->AddProc(proc1);
+    bundle2->AddProc(proc2);
+    bundle1->SetCreateTime(0); // not protected as a new started one
+    bundle2->SetCreateTime(0);
+    {
+        std::lock_guard<std::mutex> setLock(manager.totalBundlePrioSetLock_);
+        account->AddBundleToOsAccount(bundle1);
+        account->AddBundleToOsAccount(bundle2);
+        manager.osAccountsInfoMap_.insert(std::make_pair(accountId, account));
+        manager.totalBundlePrioSet_.insert(bundle1);
+        manager.totalBundlePrioSet_.insert(bundle2);
+        manager.MarkBundlePrioSnapshotDirty();
+    }
+
+    std::vector<pid_t> killedPids;
+    std::unordered_set<int> killedUids;
+    LowMemoryKiller::GetInstance().KillOneBundleByPrio(RECLAIM_PRIORITY_MAX - 1, killedPids, killedUids);
+    ASSERT_EQ(killedPids.size(), 1u);
+    EXPECT_EQ(killedPids[0], pid1);
+    EXPECT_EQ(killedUids.count(bundle1->uid_), 1u);
+
+    // the exit of victims holds the set, the state of bundle1 is not in the snapshot read
+    std::promise<void> locked;
+    std::thread holder([&manager, &locked] {
+        std::lock_guard<std::mutex> setLock(manager.totalBundlePrioSetLock_);
+        locked.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200)); // 200ms, longer than picking
+    });
+    locked.get_future().wait();
+    killedPids.clear();
+    LowMemoryKiller::GetInstance().KillOneBundleByPrio(RECLAIM_PRIORITY_MAX - 1, killedPids, killedUids);
+    holder.join();
+    ASSERT_EQ(killedPids.size(), 1u);
+    EXPECT_EQ(killedPids[0], pid2);
+
+    kill(pid1, SIGKILL); // never leave a child behind if the test fails
+    kill(pid2, SIGKILL);
+    EXPECT_EQ(waitpid(pid1, nullptr, 0), pid1);
+    EXPECT_EQ(waitpid(pid2, nullptr, 0), pid2);
+    manager.Reset();
+}
+
+HWTEST_F(LowMemoryKillerTest, KillOneProcessTest, TestSize.Level1)
+{
+    // a registered process is killed through its pidfd, with the rss cached
+    pid_t pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    ProcessHandleTable::GetInstance().handles_[pid].rssKB = 1;
+    EXPECT_EQ(LowMemoryKiller::GetInstance().KillOneProcess(pid), 1);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFSIGNALED(status));
+    ProcessHandleTable::GetInstance().Unregister(pid);
+
+    // others are killed by pid
+    pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    EXPECT_GT(LowMemoryKiller::GetInstance().KillOneProcess(pid), 0);
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFSIGNALED(status));
+}
+
 HWTEST_F(LowMemoryKillerTest, GetEventHandlerTest, TestSize.Level1)
 {
     LowMemoryKiller::GetInstance().PsiHandler();
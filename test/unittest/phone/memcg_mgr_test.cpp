@@ -109,6 +109,17 @@ HWTEST_F(MemcgMgrTest, AddProcToMemcgTest, TestSize.Level1)
     EXPECT_EQ(MemcgMgr::GetInstance().RemoveUserMemcg(memcgId), true);
 }
 
+HWTEST_F(MemcgMgrTest, AddProcsToMemcgTest, TestSize.Level1)
+{
+    unsigned int memcgId = 123457u; // ensure it is a new ID
+    std::vector<unsigned int> pids = { 1234567, 1 };
+    EXPECT_EQ(MemcgMgr::GetInstance().AddProcsToMemcg({}, memcgId), 0);
+    EXPECT_EQ(MemcgMgr::GetInstance().AddProcsToMemcg(pids, memcgId, true), 1);
+    EXPECT_EQ(MemcgMgr::GetInstance().GetUserMemcg(memcgId) != nullptr, true);
+    KernelInterface::GetInstance().WriteToFile("/dev/memcg/cgroup.procs", "1", false);
+    EXPECT_EQ(MemcgMgr::GetInstance().RemoveUserMemcg(memcgId), true);
+}
+
 HWTEST_F(MemcgMgrTest, SwapInMemcgTest, TestSize.Level1)
 {
     unsigned int memcgId = 123456u; // ensure it is a new ID
@@ -137,5 +148,22 @@ HWTEST_F(MemcgMgrTest, GetMemcgMemInfoTest, TestSize.Level1)
     EXPECT_EQ(MemcgMgr::GetInstance().RemoveUserMemcg(memcgId), true);
     EXPECT_EQ(MemcgMgr::GetInstance().GetMemcgMemInfo(memcgId) == nullptr, true);
 }
+
+HWTEST_F(MemcgMgrTest, AppMemcgTest, TestSize.Level1)
+{
+    unsigned int memcgId = 123456u; // ensure it is a new ID
+    int appUid = 20010001;
+    EXPECT_EQ(MemcgMgr::GetInstance().GetAppMemcg(appUid) == nullptr, true);
+    EXPECT_EQ(MemcgMgr::GetInstance().AddProcToAppMemcg(1, memcgId, appUid), true);
+    AppMemcg* memcg = MemcgMgr::GetInstance().GetAppMemcg(appUid);
+    ASSERT_EQ(memcg != nullptr, true);
+    EXPECT_STREQ(memcg->GetMemcgPath_().c_str(), "/dev/memcg/123456/20010001");
+    ReclaimRatios ratios;
+    EXPECT_EQ(MemcgMgr::GetInstance().UpdateAppMemcgScoreAndReclaimRatios(appUid, 800, ratios), true);
+    KernelInterface::GetInstance().WriteToFile("/dev/memcg/cgroup.procs", "1", false);
+    // app memcgs are removed with their user memcg
+    EXPECT_EQ(MemcgMgr::GetInstance().RemoveUserMemcg(memcgId), true);
+    EXPECT_EQ(MemcgMgr::GetInstance().GetAppMemcg(appUid) == nullptr, true);
+}
 }
 }
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "memcg_stats_sampler.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+class MemcgStatsSamplerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void MemcgStatsSamplerTest::SetUpTestCase()
+{
+}
+
+void MemcgStatsSamplerTest::TearDownTestCase()
+{
+}
+
+void MemcgStatsSamplerTest::SetUp()
+{
+    MemcgStatsSampler::GetInstance().Stop();
+    MemcgStatsSampler::GetInstance().samples_.clear();
+    MemcgStatsSampler::GetInstance().appSamples_.clear();
+}
+
+void MemcgStatsSamplerTest::TearDown()
+{
+    MemcgStatsSampler::GetInstance().samples_.clear();
+    MemcgStatsSampler::GetInstance().appSamples_.clear();
+}
+
+static MemcgStat MakeStat(long long anonKiB, long long zramKiB, long long eswapKiB, long long refaults)
+{
+    MemcgStat stat;
+    stat.anonKiB = anonKiB;
+    stat.zramKiB = zramKiB;
+    stat.eswapKiB = eswapKiB;
+    stat.refaults = refaults;
+    return stat;
+}
+
+HWTEST_F(MemcgStatsSamplerTest, DeltaTest, TestSize.Level1)
+{
+    MemcgStatsSampler &sampler = MemcgStatsSampler::GetInstance();
+    unsigned int userId = 100;
+    sampler.AddSample(userId, 1000, MakeStat(1000, 100, 10, 5));
+    sampler.AddSample(userId, 2000, MakeStat(800, 250, 20, 9));
+
+    MemcgStatsSample sample;
+    EXPECT_TRUE(sampler.GetLatestSample(userId, sample));
+    EXPECT_EQ(sample.timeMs, 2000);
+    EXPECT_EQ(sample.anonDeltaKiB, -200);
+    EXPECT_EQ(sample.zramDeltaKiB, 150);
+    EXPECT_EQ(sample.eswapDeltaKiB, 10);
+    EXPECT_EQ(sample.refaultDelta, 4);
+    EXPECT_FALSE(sampler.GetLatestSample(userId + 1, sample));
+
+    // refaults restart from 0 if the memcg is recreated
+    sampler.AddSample(userId, 3000, MakeStat(800, 250, 20, 1));
+    EXPECT_TRUE(sampler.GetLatestSample(userId, sample));
+    EXPECT_EQ(sample.refaultDelta, 0);
+}
+
+HWTEST_F(MemcgStatsSamplerTest, KeepLastSamplesTest, TestSize.Level1)
+{
+    MemcgStatsSampler &sampler = MemcgStatsSampler::GetInstance();
+    sampler.sampleCount_ = 3;
+    unsigned int userId = 100;
+    for (int i = 0; i < 5; i++) {
+        sampler.AddSample(userId, i, MakeStat(i, 0, 0, 0));
+    }
+    std::vector<MemcgStatsSample> samples = sampler.GetSamples(userId);
+    ASSERT_EQ(samples.size(), 3u);
+    EXPECT_EQ(samples.front().timeMs, 2);
+    EXPECT_EQ(samples.back().timeMs, 4);
+
+    // samples of removed memcgs are dropped
+    sampler.AddSample(userId + 1, 0, MakeStat(0, 0, 0, 0));
+    sampler.RetainMemcgs({ userId + 1 });
+    EXPECT_TRUE(sampler.GetSamples(userId).empty());
+    EXPECT_EQ(sampler.GetSamples(userId + 1).size(), 1u);
+    sampler.sampleCount_ = MEMCG_STATS_SAMPLE_COUNT;
+}
+
+HWTEST_F(MemcgStatsSamplerTest, AppSamplesTest, TestSize.Level1)
+{
+    MemcgStatsSampler &sampler = MemcgStatsSampler::GetInstance();
+    int appUid = 20010001;
+    sampler.AddAppSample(appUid, 1000, MakeStat(1000, 100, 10, 5));
+    sampler.AddAppSample(appUid, 2000, MakeStat(900, 200, 10, 8));
+    std::vector<MemcgStatsSample> samples = sampler.GetAppSamples(appUid);
+    ASSERT_EQ(samples.size(), 2u);
+    EXPECT_EQ(samples.back().anonDeltaKiB, -100);
+    EXPECT_EQ(samples.back().refaultDelta, 3);
+    // apps and users are apart even if an id is the same
+    EXPECT_TRUE(sampler.GetSamples(static_cast<unsigned int>(appUid)).empty());
+
+    // samples of removed app memcgs are dropped
+    sampler.RetainAppMemcgs({ appUid + 1 });
+    EXPECT_TRUE(sampler.GetAppSamples(appUid).empty());
+}
+}
+}
@@ -19,6 +19,7 @@
 
 #define private public
 #define protected public
+#include "kernel_interface.h"
 #include "memcg.h"
 #undef private
 #undef protected
@@ -117,6 +118,93 @@ HWTEST_F(MemcgTest, SetScoreAndReclaimRatiosToKernelTest, TestSize.Level1)
     memcg = nullptr;
 }
 
+HWTEST_F(MemcgTest, AppliedParamsTest, TestSize.Level1)
+{
+    Memcg* memcg = new Memcg();
+    EXPECT_EQ(memcg->ReconcileWithKernel(), true); // nothing written yet
+    memcg->SetScore(100);
+    memcg->SetReclaimRatios(50, 50, 50);
+    memcg->applied_.scoreValid = true;
+    memcg->applied_.ratiosValid = true;
+    memcg->applied_.score = 100;
+    memcg->applied_.mem2zramRatio = 50;
+    memcg->applied_.zram2ufsRatio = 50;
+    memcg->applied_.refaultThreshold = 50;
+    EXPECT_EQ(memcg->RatiosApplied_(), true);
+    EXPECT_EQ(memcg->SetScoreAndReclaimRatiosToKernel(), true); // same values, nothing to write
+    memcg->SetReclaimRatios(60, 50, 50);
+    EXPECT_EQ(memcg->RatiosApplied_(), false);
+    memcg->ResetAppliedParams_();
+    EXPECT_EQ(memcg->applied_.scoreValid, false);
+    EXPECT_EQ(memcg->applied_.ratiosValid, false);
+    delete memcg;
+    memcg = nullptr;
+}
+
+HWTEST_F(MemcgTest, WriteChangedParamsOnlyTest, TestSize.Level1)
+{
+    Memcg* memcg = new Memcg();
+    int score = 0;
+    unsigned int mem2zramRatio = 0;
+    unsigned int zram2ufsRatio = 0;
+    unsigned int refaultThreshold = 0;
+    ASSERT_EQ(memcg->ReadScoreAndReclaimRatiosFromKernel_(score, mem2zramRatio, zram2ufsRatio, refaultThreshold), true);
+    ReclaimRatios origin(mem2zramRatio, zram2ufsRatio, refaultThreshold);
+    std::string paramPath = KernelInterface::GetInstance().JoinPath(memcg->GetMemcgPath_(),
+        "memory.zswapd_single_memcg_param");
+
+    memcg->SetScore(score);
+    memcg->SetReclaimRatios(50, 50, 50);
+    EXPECT_EQ(memcg->SetScoreAndReclaimRatiosToKernel(), true);
+    EXPECT_EQ(memcg->ReconcileWithKernel(), true);
+
+    // changed out of memmgr, an identical call writes nothing
+    EXPECT_EQ(KernelInterface::GetInstance().WriteToFile(paramPath, "60 50 50"), true);
+    EXPECT_EQ(memcg->SetScoreAndReclaimRatiosToKernel(), true);
+    EXPECT_EQ(memcg->ReadScoreAndReclaimRatiosFromKernel_(score, mem2zramRatio, zram2ufsRatio, refaultThreshold), true);
+    EXPECT_EQ(mem2zramRatio, 60u);
+
+    // values of kernel are adopted once the mismatch is found
+    EXPECT_EQ(memcg->ReconcileWithKernel(), false);
+    EXPECT_EQ(memcg->score_, score);
+    EXPECT_EQ(memcg->reclaimRatios_->mem2zramRatio_, 60u);
+    EXPECT_EQ(memcg->reclaimRatios_->zram2ufsRatio_, 50u);
+    EXPECT_EQ(memcg->ReconcileWithKernel(), true);
+
+    memcg->SetReclaimRatios(origin);
+    EXPECT_EQ(memcg->SetScoreAndReclaimRatiosToKernel(), true);
+    delete memcg;
+    memcg = nullptr;
+}
+
+HWTEST_F(MemcgTest, RetryFailedWriteTest, TestSize.Level1)
+{
+    unsigned int userId = 234567; // 234567: a user without memcg
+    UserMemcg* memcg = new UserMemcg(userId);
+    memcg->RemoveMemcgDir();
+    memcg->SetScore(100);
+    memcg->SetReclaimRatios(50, 50, 50);
+    EXPECT_EQ(memcg->SetScoreAndReclaimRatiosToKernel(), false);
+    EXPECT_EQ(memcg->applied_.writeFailed, true);
+
+    // the dir appears later, reconcile writes the values failed
+    ASSERT_EQ(KernelInterface::GetInstance().CreateDir(memcg->GetMemcgPath_()), true);
+    EXPECT_EQ(memcg->ReconcileWithKernel(), true);
+    EXPECT_EQ(memcg->applied_.writeFailed, false);
+    int score = 0;
+    unsigned int mem2zramRatio = 0;
+    unsigned int zram2ufsRatio = 0;
+    unsigned int refaultThreshold = 0;
+    EXPECT_EQ(memcg->ReadScoreAndReclaimRatiosFromKernel_(score, mem2zramRatio, zram2ufsRatio, refaultThreshold), true);
+    EXPECT_EQ(score, 100);
+    EXPECT_EQ(mem2zramRatio, 50u);
+    EXPECT_EQ(memcg->ReconcileWithKernel(), true);
+
+    memcg->RemoveMemcgDir();
+    delete memcg;
+    memcg = nullptr;
+}
+
 HWTEST_F(MemcgTest, SwapInTest, TestSize.Level1)
 {
     Memcg* memcg = new Memcg();
@@ -220,5 +308,36 @@ HWTEST_F(MemcgTest, AddProcTest, TestSize.Level1)
     EXPECT_EQ(usermemcg.AddProc(userId), false);
     EXPECT_EQ(usermemcg.RemoveMemcgDir(), true);
 }
+
+HWTEST_F(MemcgTest, ParseMemcgStatTest, TestSize.Level1)
+{
+    const char content[] = "Inactive(anon): 10 kB\nAnon: 1024 kB\nFile: 512 kB\nzram: 256 kB\n"
+        "Eswap: 128 kB\nworkingset_refault_anon: 3\nworkingset_refault_file: 4\n";
+    MemcgStat stat;
+    EXPECT_TRUE(Memcg::ParseMemcgStat(content, sizeof(content) - 1, stat));
+    EXPECT_EQ(stat.anonKiB, 1024);
+    EXPECT_EQ(stat.zramKiB, 256);
+    EXPECT_EQ(stat.eswapKiB, 128);
+    EXPECT_EQ(stat.refaults, 7);
+    EXPECT_TRUE(stat.refaultsValid);
+
+    // fields added by kernel and order of fields do not matter
+    const char reordered[] = "Eswap: 1 kB\nNewField: 9 kB\nZram: 2 kB\nAnon: 3 kB\nworkingset_refault: 5\n";
+    EXPECT_TRUE(Memcg::ParseMemcgStat(reordered, sizeof(reordered) - 1, stat));
+    EXPECT_EQ(stat.anonKiB, 3);
+    EXPECT_EQ(stat.zramKiB, 2);
+    EXPECT_EQ(stat.eswapKiB, 1);
+    EXPECT_EQ(stat.refaults, 5);
+    EXPECT_TRUE(stat.refaultsValid);
+
+    // refaults not counted by kernel
+    const char noRefault[] = "Anon: 3 kB\nzram: 2 kB\nEswap: 1 kB\n";
+    EXPECT_TRUE(Memcg::ParseMemcgStat(noRefault, sizeof(noRefault) - 1, stat));
+    EXPECT_EQ(stat.refaults, 0);
+    EXPECT_FALSE(stat.refaultsValid);
+
+    const char missing[] = "Anon: 3 kB\nzram: 2 kB\n";
+    EXPECT_FALSE(Memcg::ParseMemcgStat(missing, sizeof(missing) - 1, stat));
+}
 }
 }
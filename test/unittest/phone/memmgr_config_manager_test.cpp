@@ -57,5 +57,30 @@ HWTEST_F(MemmgrConfigManagerTest, initTest, TestSize.Level1)
 {
     EXPECT_EQ(MemmgrConfigManager::GetInstance().Init(), true);
 }
+
+HWTEST_F(MemmgrConfigManagerTest, PsiConfigDefaultTest, TestSize.Level1)
+{
+    PsiConfig psiConfig;
+    psiConfig.ParseConfig(nullptr);
+    const PsiConfig::PsiTriggerList &triggers = psiConfig.GetPsiTriggers();
+    EXPECT_EQ(triggers.size(), 1u);
+    EXPECT_EQ(triggers[0].stallType, StallType::SOME);
+    EXPECT_EQ(triggers[0].thresholdMs, PSI_DEFAULT_THRESHOLD_MS);
+    EXPECT_EQ(triggers[0].windowMs, PSI_DEFAULT_WINDOW_MS);
+}
+
+HWTEST_F(MemmgrConfigManagerTest, PsiConfigLevelTest, TestSize.Level1)
+{
+    EXPECT_EQ(MemmgrConfigManager::GetInstance().Init(), true);
+    const PsiConfig::PsiTriggerList &triggers = MemmgrConfigManager::GetInstance().GetPsiConfig().GetPsiTriggers();
+    EXPECT_GE(triggers.size(), 1u);
+    EXPECT_LE(triggers.size(), PSI_MAX_LEVEL_COUNT);
+    for (auto &trigger : triggers) {
+        EXPECT_GT(trigger.thresholdMs, 0u);
+        EXPECT_LE(trigger.thresholdMs, trigger.windowMs);
+        EXPECT_GE(trigger.windowMs, PSI_MIN_WINDOW_MS);
+        EXPECT_LE(trigger.windowMs, PSI_MAX_WINDOW_MS);
+    }
+}
 }
 }
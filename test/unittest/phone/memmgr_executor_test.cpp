@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <unistd.h>
+
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "memmgr_executor.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+class MemMgrExecutorTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void MemMgrExecutorTest::SetUpTestCase()
+{
+}
+
+void MemMgrExecutorTest::TearDownTestCase()
+{
+}
+
+void MemMgrExecutorTest::SetUp()
+{
+}
+
+void MemMgrExecutorTest::TearDown()
+{
+}
+
+HWTEST_F(MemMgrExecutorTest, SharedRunnerTest, TestSize.Level1)
+{
+    auto runner = MemMgrExecutor::GetInstance().GetRunner(ExecutorLane::RECLAIM);
+    EXPECT_NE(runner, nullptr);
+    EXPECT_EQ(MemMgrExecutor::GetInstance().GetRunner(ExecutorLane::RECLAIM), runner);
+    EXPECT_NE(MemMgrExecutor::GetInstance().GetRunner(ExecutorLane::KILL), runner);
+    EXPECT_EQ(MemMgrExecutor::GetInstance().GetRunner(ExecutorLane::COUNT), nullptr);
+    LaneStats stats;
+    EXPECT_EQ(MemMgrExecutor::GetInstance().GetLaneStats(ExecutorLane::COUNT, stats), false);
+}
+
+HWTEST_F(MemMgrExecutorTest, LaneStatsTest, TestSize.Level1)
+{
+    auto handler = std::make_shared<LaneHandler>(ExecutorLane::TIMER);
+    EXPECT_EQ(handler->GetLane(), ExecutorLane::TIMER);
+    LaneStats before;
+    EXPECT_EQ(MemMgrExecutor::GetInstance().GetLaneStats(ExecutorLane::TIMER, before), true);
+
+    std::atomic<int> executed {0};
+    EXPECT_EQ(handler->PostImmediateTask([&executed] { executed++; }), true);
+    EXPECT_EQ(handler->PostSyncTask([&executed] { executed++; }), true);
+    EXPECT_EQ(handler->PostTask([&executed] { executed++; }, "LaneStatsTest", 10000), true); // 10000: 10s later
+    handler->RemoveTask("LaneStatsTest");
+    usleep(100 * 1000); // 100ms: wait for the immediate task
+
+    LaneStats after;
+    EXPECT_EQ(MemMgrExecutor::GetInstance().GetLaneStats(ExecutorLane::TIMER, after), true);
+    EXPECT_EQ(executed.load(), 2); // 2: the removed one is not executed
+    EXPECT_EQ(after.posted - before.posted, 3u); // 3: tasks posted
+    EXPECT_EQ(after.executed - before.executed, 2u); // 2: tasks executed
+    EXPECT_EQ(after.cancelled - before.cancelled, 1u);
+    EXPECT_EQ(after.depth, before.depth);
+}
+
+/**
+ * @tc.name: KillLaneNotBlockedTest
+ * @tc.desc: Test the kill lane is not blocked by bookkeeping work
+ * @tc.type: FUNC
+ */
+HWTEST_F(MemMgrExecutorTest, KillLaneNotBlockedTest, TestSize.Level1)
+{
+    auto bookkeeping = std::make_shared<LaneHandler>(ExecutorLane::BOOKKEEPING);
+    auto kill = std::make_shared<LaneHandler>(ExecutorLane::KILL);
+    std::atomic<bool> bookkeepingDone {false};
+    std::atomic<bool> killDone {false};
+    EXPECT_EQ(bookkeeping->PostImmediateTask([&bookkeepingDone] {
+        usleep(300 * 1000); // 300ms: long bookkeeping work
+        bookkeepingDone = true;
+    }), true);
+    EXPECT_EQ(kill->PostImmediateTask([&killDone] { killDone = true; }), true);
+    usleep(100 * 1000); // 100ms: enough for the kill task
+    EXPECT_EQ(killDone.load(), true);
+    EXPECT_EQ(bookkeepingDone.load(), false);
+    usleep(300 * 1000); // 300ms: wait for the bookkeeping work
+    EXPECT_EQ(bookkeepingDone.load(), true);
+}
+}
+}
@@ -15,6 +15,10 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdio>
+#include <unistd.h>
+#include <vector>
+
 #include "utils.h"
 
 #define private public
@@ -98,5 +102,36 @@ HWTEST_F(OomScoreAdjUtilsTest, WriteOomScoreAdjToKernelTest2, TestSize.Level1)
     EXPECT_EQ(ret, true);
 }
 
+/**
+ * @tc.name: WriteOomScoreAdjBatch
+ * @tc.desc: Test unchanged values are not written again, and values of died processes are not cached
+ * @tc.type: FUNC
+ */
+HWTEST_F(OomScoreAdjUtilsTest, WriteOomScoreAdjBatchTest, TestSize.Level1)
+{
+    OomScoreAdjUtils::ClearCache();
+    pid_t self = getpid();
+    int current = 0;
+    FILE *file = fopen("/proc/self/oom_score_adj", "r");
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(fscanf(file, "%d", &current), 1);
+    fclose(file);
+
+    // writing the current value is always permitted
+    std::vector<OomScoreAdjUtils::OomScoreAdjWrite> writes = { {self, current}, {0, current} };
+    EXPECT_EQ(OomScoreAdjUtils::WriteOomScoreAdjBatch(writes), 1);
+    int cached = 0;
+    EXPECT_EQ(OomScoreAdjUtils::GetCachedOomScoreAdj(self, cached), true);
+    EXPECT_EQ(cached, current);
+    EXPECT_EQ(OomScoreAdjUtils::GetCachedOomScoreAdj(0, cached), false);
+    EXPECT_EQ(OomScoreAdjUtils::WriteOomScoreAdjBatch(writes), 0);
+
+    OomScoreAdjUtils::ForgetProcess(self);
+    EXPECT_EQ(OomScoreAdjUtils::GetCachedOomScoreAdj(self, cached), false);
+    EXPECT_EQ(OomScoreAdjUtils::WriteOomScoreAdjBatch(writes), 1);
+    OomScoreAdjUtils::ClearCache();
+    EXPECT_EQ(OomScoreAdjUtils::GetCachedOomScoreAdj(self, cached), false);
+}
+
 }
 }
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "kernel_interface.h"
+#include "process_handle_table.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+class ProcessHandleTableTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void ProcessHandleTableTest::SetUpTestCase()
+{
+}
+
+void ProcessHandleTableTest::TearDownTestCase()
+{
+}
+
+void ProcessHandleTableTest::SetUp()
+{
+}
+
+void ProcessHandleTableTest::TearDown()
+{
+    ProcessHandleTable::GetInstance().SetExitCallback(nullptr);
+    ProcessHandleTable::GetInstance().Clear();
+}
+
+static pid_t ForkSleepingChild()
+{
+    pid_t pid = fork();
+    if (pid == 0) {
+        while (true) {
+            pause();
+        }
+    }
+    return pid;
+}
+
+HWTEST_F(ProcessHandleTableTest, RegisterTest, TestSize.Level1)
+{
+    pid_t pid = getpid();
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().Register(0));
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().IsRegistered(pid));
+    EXPECT_EQ(ProcessHandleTable::GetInstance().Size(), 1);
+
+    ProcessHandle handle;
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().GetHandle(pid, handle));
+    EXPECT_GE(handle.pidfd, 0);
+    EXPECT_GT(handle.rssKB, 0);
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().Refresh(pid));
+
+    // register again will replace the old handle
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    EXPECT_EQ(ProcessHandleTable::GetInstance().Size(), 1);
+
+    ProcessHandleTable::GetInstance().Unregister(pid);
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().IsRegistered(pid));
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().Refresh(pid));
+}
+
+HWTEST_F(ProcessHandleTableTest, KillProcessTest, TestSize.Level1)
+{
+    int freedKB = 0;
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().KillProcess(0, freedKB));
+
+    pid_t pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().KillProcess(pid, freedKB));
+    EXPECT_GT(freedKB, 0);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGKILL);
+
+    // handle of the died process is dropped on refresh
+    ProcessHandleTable::GetInstance().RefreshAll();
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().IsRegistered(pid));
+}
+
+HWTEST_F(ProcessHandleTableTest, KillOneProcessByPidTest, TestSize.Level1)
+{
+    pid_t pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    EXPECT_GT(KernelInterface::GetInstance().KillOneProcessByPid(pid), 0);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFSIGNALED(status));
+
+    // pid is reaped, kill through the stale handle must not signal others
+    int freedKB = 0;
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().KillProcess(pid, freedKB));
+    EXPECT_EQ(freedKB, 0);
+}
+
+HWTEST_F(ProcessHandleTableTest, KillByCachedSampleTest, TestSize.Level1)
+{
+    pid_t pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    // the kill is decided by the state cached, not by reading procfs again
+    ProcessHandleTable::GetInstance().handles_[pid].state = 'D';
+    int freedKB = 0;
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().KillProcess(pid, freedKB));
+    EXPECT_EQ(freedKB, 0);
+    EXPECT_EQ(waitpid(pid, nullptr, WNOHANG), 0);
+
+    // the state is corrected by refresh, the rss cached is reported as freed
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Refresh(pid));
+    ProcessHandleTable::GetInstance().handles_[pid].rssKB = 1;
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().KillProcess(pid, freedKB));
+    EXPECT_EQ(freedKB, 1);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFSIGNALED(status));
+}
+
+HWTEST_F(ProcessHandleTableTest, WaitForExitTest, TestSize.Level1)
+{
+    pid_t pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    std::vector<pid_t> pids = { pid };
+    // alive process, wait until timeout
+    EXPECT_EQ(ProcessHandleTable::GetInstance().WaitForExit(pids, 10), 0);
+
+    int freedKB = 0;
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().KillProcess(pid, freedKB));
+    EXPECT_EQ(ProcessHandleTable::GetInstance().WaitForExit(pids, 1000), 1);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+
+    // not registered pid is treated as exited
+    pids.push_back(0);
+    EXPECT_EQ(ProcessHandleTable::GetInstance().WaitForExit(pids, 10), 2);
+}
+
+HWTEST_F(ProcessHandleTableTest, ExitCallbackTest, TestSize.Level1)
+{
+    const int uid = 20010001;
+    std::atomic<pid_t> exitedPid {0};
+    std::atomic<int> exitedUid {-1};
+    ProcessHandleTable::GetInstance().SetExitCallback([&exitedPid, &exitedUid](pid_t pid, int uid) {
+        exitedUid = uid;
+        exitedPid = pid;
+    });
+
+    pid_t pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Register(pid, uid));
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().IsExitWatchComplete());
+    ProcessHandle handle;
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().GetHandle(pid, handle));
+    EXPECT_TRUE(handle.watched);
+
+    kill(pid, SIGKILL);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    for (int i = 0; i < 100 && exitedPid != pid; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(exitedPid, pid);
+    EXPECT_EQ(exitedUid, uid);
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().IsRegistered(pid));
+}
+
+HWTEST_F(ProcessHandleTableTest, UnwatchedPidsTest, TestSize.Level1)
+{
+    pid_t pid = ForkSleepingChild();
+    ASSERT_GT(pid, 0);
+    // registered before the exit callback is set, its exit is not watched
+    ASSERT_TRUE(ProcessHandleTable::GetInstance().Register(pid));
+    ProcessHandleTable::GetInstance().SetExitCallback([](pid_t, int) {});
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().IsExitWatchComplete());
+    ProcessHandleTable::GetInstance().Unregister(pid);
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().IsExitWatchComplete());
+
+    // a process exited before registered is not left as unwatched
+    kill(pid, SIGKILL);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_FALSE(ProcessHandleTable::GetInstance().Register(pid));
+    EXPECT_TRUE(ProcessHandleTable::GetInstance().IsExitWatchComplete());
+}
+} // namespace Memory
+} // namespace OHOS
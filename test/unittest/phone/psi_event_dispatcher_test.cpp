@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <unistd.h>
+
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "psi_event_dispatcher.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+class PsiEventDispatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void PsiEventDispatcherTest::SetUpTestCase()
+{
+}
+
+void PsiEventDispatcherTest::TearDownTestCase()
+{
+}
+
+void PsiEventDispatcherTest::SetUp()
+{
+}
+
+void PsiEventDispatcherTest::TearDown()
+{
+}
+
+HWTEST_F(PsiEventDispatcherTest, AddConsumerTest, TestSize.Level1)
+{
+    auto handler = std::make_shared<LaneHandler>(ExecutorLane::KILL);
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().AddConsumer("AddConsumerTest", handler, [](int) {}), true);
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().AddConsumer("AddConsumerTest", handler, [](int) {}), false);
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().AddConsumer("AddConsumerTest2", nullptr, [](int) {}), false);
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().Dispatch("NotAddedConsumer"), false);
+}
+
+/**
+ * @tc.name: CoalesceBurstTest
+ * @tc.desc: Test a burst of events is collapsed into at most one pending evaluation
+ *           and one more pass for the events arrived during the running one
+ * @tc.type: FUNC
+ */
+HWTEST_F(PsiEventDispatcherTest, CoalesceBurstTest, TestSize.Level1)
+{
+    const int eventCount = 10;
+    const int evaluateUs = 100 * 1000;
+    std::atomic<int> evaluated {0};
+    auto handler = std::make_shared<LaneHandler>(ExecutorLane::KILL);
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().AddConsumer("CoalesceBurstTest", handler,
+        [&evaluated, evaluateUs](int) {
+            usleep(evaluateUs);
+            evaluated++;
+        }), true);
+
+    for (int i = 0; i < eventCount; i++) {
+        EXPECT_EQ(PsiEventDispatcher::GetInstance().Dispatch("CoalesceBurstTest"), true);
+    }
+    usleep(evaluateUs * 5); // 5: enough for two passes
+
+    PsiConsumerStats stats;
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().GetConsumerStats("CoalesceBurstTest", stats), true);
+    EXPECT_EQ(stats.events, static_cast<uint64_t>(eventCount));
+    EXPECT_GE(stats.runs, 1u);
+    EXPECT_LE(stats.runs, 2u);
+    EXPECT_EQ(stats.merged, static_cast<uint64_t>(eventCount - 1));
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(static_cast<uint64_t>(evaluated.load()), stats.runs);
+
+    // a new event after the burst is evaluated again
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().Dispatch("CoalesceBurstTest"), true);
+    usleep(evaluateUs * 3); // 3: enough for one pass
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().GetConsumerStats("CoalesceBurstTest", stats), true);
+    EXPECT_EQ(stats.events, static_cast<uint64_t>(eventCount + 1));
+    EXPECT_EQ(static_cast<uint64_t>(evaluated.load()), stats.runs);
+    EXPECT_EQ(stats.merged, static_cast<uint64_t>(eventCount - 1));
+}
+
+/**
+ * @tc.name: LevelMergeTest
+ * @tc.desc: Test merged events are evaluated with the most urgent level of them
+ * @tc.type: FUNC
+ */
+HWTEST_F(PsiEventDispatcherTest, LevelMergeTest, TestSize.Level1)
+{
+    const int evaluateUs = 100 * 1000;
+    std::atomic<int> lastLevel {-1};
+    auto handler = std::make_shared<LaneHandler>(ExecutorLane::KILL);
+    auto func = [&lastLevel, evaluateUs](int level) {
+        usleep(evaluateUs);
+        lastLevel = level;
+    };
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().AddConsumer("LevelMergeTest", handler, func), true);
+
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().Dispatch("LevelMergeTest", 0), true);
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().Dispatch("LevelMergeTest", 2), true); // 2: most urgent level
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().Dispatch("LevelMergeTest", 1), true);
+    usleep(evaluateUs * 5); // 5: enough for two passes
+
+    PsiConsumerStats stats;
+    EXPECT_EQ(PsiEventDispatcher::GetInstance().GetConsumerStats("LevelMergeTest", stats), true);
+    EXPECT_EQ(lastLevel.load(), 2); // 2: most urgent level
+    EXPECT_EQ(stats.lastLevel, 2); // 2: most urgent level
+}
+}
+}
@@ -15,6 +15,9 @@
 
 #include "gtest/gtest.h"
 
+#include <future>
+#include <thread>
+
 #include "utils.h"
 
 #define private public
@@ -768,6 +771,71 @@ HWTEST_F(ReclaimPriorityManagerTest, GetOneKillableBundleTest, TestSize.Level1)
     EXPECT_LT(bundle3->priority_, minPrio);
 }
 
+/**
+ * @tc.name: BundlePrioSnapshotTest
+ * @tc.desc: Test the published snapshot is in descending order of priority, unchanged bundles
+ *           are shared between snapshots and old snapshot is not affected by later updates
+ * @tc.type: FUNC
+ */
+HWTEST_F(ReclaimPriorityManagerTest, BundlePrioSnapshotTest, TestSize.Level1)
+{
+    ReclaimPriorityManager manager;
+    int accountId = 100;
+    std::shared_ptr<BundlePriorityInfo> bundle1 = std::make_shared<BundlePriorityInfo>("app1",
+            accountId * USER_ID_SHIFT + 1, 100);
+    std::shared_ptr<BundlePriorityInfo> bundle2 = std::make_shared<BundlePriorityInfo>("app2",
+            accountId * USER_ID_SHIFT + 2, 800);
+    ProcessPriorityInfo proc1(1001, bundle1->uid_, 100);
+    ProcessPriorityInfo proc2(1002, bundle2->uid_, 800);
+    bundle1->AddProc(proc1);
+    bundle2->AddProc(proc2);
+    manager.totalBundlePrioSet_.insert(bundle1);
+    manager.totalBundlePrioSet_.insert(bundle2);
+    manager.MarkBundlePrioSnapshotDirty();
+
+    BundlePrioritySnapshotPtr snapshot1 = manager.GetBundlePrioSnapshot();
+    ASSERT_EQ(snapshot1->Size(), 2u);
+    EXPECT_EQ(snapshot1->GetBundles()[0]->uid, bundle2->uid_);
+    EXPECT_EQ(snapshot1->GetBundles()[1]->uid, bundle1->uid_);
+    ASSERT_EQ(snapshot1->GetBundles()[1]->pids.size(), 1u);
+    EXPECT_EQ(snapshot1->GetBundles()[1]->pids[0], 1001);
+
+    bundle1->SetPriority(900);
+    manager.totalBundlePrioSet_.Update(bundle1);
+    manager.MarkBundlePrioSnapshotDirty();
+
+    BundlePrioritySnapshotPtr snapshot2 = manager.GetBundlePrioSnapshot();
+    ASSERT_EQ(snapshot2->Size(), 2u);
+    EXPECT_GT(snapshot2->GetVersion(), snapshot1->GetVersion());
+    EXPECT_EQ(snapshot2->GetBundles()[0]->uid, bundle1->uid_);
+    EXPECT_EQ(snapshot2->GetBundles()[0]->priority, 900);
+    EXPECT_EQ(snapshot2->GetBundles()[1], snapshot1->GetBundles()[0]);
+    EXPECT_EQ(snapshot1->GetBundles()[1]->priority, 100);
+
+    // readers never wait for a writer holding the set, they get the last snapshot built
+    bundle2->SetPriority(950);
+    manager.totalBundlePrioSet_.Update(bundle2);
+    manager.MarkBundlePrioSnapshotDirty();
+    std::promise<void> locked;
+    std::promise<void> read;
+    std::thread writer([&manager, &locked, &read] {
+        std::lock_guard<std::mutex> setLock(manager.totalBundlePrioSetLock_);
+        locked.set_value();
+        read.get_future().wait();
+    });
+    locked.get_future().wait();
+    EXPECT_EQ(manager.GetBundlePrioSnapshot(), snapshot2);
+    read.set_value();
+    writer.join();
+    BundlePrioritySnapshotPtr snapshot3 = manager.GetBundlePrioSnapshot();
+    EXPECT_EQ(snapshot3->GetBundles()[0]->uid, bundle2->uid_);
+    EXPECT_EQ(manager.GetBundlePrioSnapshot(), snapshot3); // built once for a batch of updates
+
+    manager.Reset();
+    EXPECT_EQ(manager.GetBundlePrioSnapshot()->Size(), 0u);
+    EXPECT_EQ(snapshot2->Size(), 2u);
+}
+
 /**
  * @tc.name: AppStateUpdateResonToString
  * @tc.desc: Test the branch into "if == true"
@@ -1020,5 +1088,248 @@ HWTEST_F(ReclaimPriorityManagerTest, UpdatePriorityByProcForExtensionTest2, Test
     ReclaimPriorityManager::GetInstance().UpdateReclaimPriorityInner(request6);
     ReclaimPriorityManager::GetInstance().UpdateReclaimPriorityInner(request7);
 }
+
+HWTEST_F(ReclaimPriorityManagerTest, ExtensionBindCycleTest, TestSize.Level1)
+{
+    ProcUpdateInfo caller = {10060, 20010060, "com.ohos.exten_cycle_test.caller"};
+    ProcUpdateInfo extA = {10061, 20010061, "com.ohos.exten_cycle_test.a"};
+    ProcUpdateInfo extB = {10062, 20010062, "com.ohos.exten_cycle_test.b"};
+    ReclaimPriorityManager &manager = ReclaimPriorityManager::GetInstance();
+    for (auto &info : {caller, extA, extB}) {
+        manager.UpdateReclaimPriorityInner(
+            CreateUpdateRequest(info.pid, info.uid, info.bundleName, AppStateUpdateReason::CREATE_PROCESS));
+    }
+    auto findProc = [&manager](const ProcUpdateInfo &info) -> ProcessPriorityInfo& {
+        std::shared_ptr<AccountBundleInfo> account = manager.FindOsAccountById(GetOsAccountIdByUid(info.uid));
+        return account->FindBundleById(info.uid)->FindProcByPid(info.pid);
+    };
+    ProcessPriorityInfo &callerProc = findProc(caller);
+    ProcessPriorityInfo &procA = findProc(extA);
+    ProcessPriorityInfo &procB = findProc(extB);
+
+    // caller -> A -> B -> A
+    manager.UpdateReclaimPriorityInner(CreateUpdateRequestForExtension(
+        caller, extA, AppStateUpdateReason::BIND_EXTENSION));
+    manager.UpdateReclaimPriorityInner(CreateUpdateRequestForExtension(
+        extA, extB, AppStateUpdateReason::BIND_EXTENSION));
+    manager.UpdateReclaimPriorityInner(CreateUpdateRequestForExtension(
+        extB, extA, AppStateUpdateReason::BIND_EXTENSION));
+    EXPECT_EQ(callerProc.priority_, RECLAIM_PRIORITY_FOREGROUND);
+    EXPECT_EQ(procA.priority_, RECLAIM_PRIORITY_FG_BIND_EXTENSION);
+    EXPECT_EQ(procB.priority_, RECLAIM_PRIORITY_BG_PERCEIVED);
+
+    // the cycle does not keep A and B important after the caller goes background
+    manager.UpdateReclaimPriorityInner(
+        CreateUpdateRequest(caller.pid, caller.uid, caller.bundleName, AppStateUpdateReason::BACKGROUND));
+    EXPECT_EQ(callerProc.priority_, RECLAIM_PRIORITY_BACKGROUND);
+    EXPECT_EQ(procA.priority_, RECLAIM_PRIORITY_NO_BIND_EXTENSION);
+    EXPECT_EQ(procB.priority_, RECLAIM_PRIORITY_NO_BIND_EXTENSION);
+
+    for (auto &info : {caller, extA, extB}) {
+        manager.UpdateReclaimPriorityInner(
+            CreateUpdateRequest(info.pid, info.uid, info.bundleName, AppStateUpdateReason::PROCESS_TERMINATED));
+    }
+}
+
+HWTEST_F(ReclaimPriorityManagerTest, ApplyCoalescedUpdatesTest, TestSize.Level1)
+{
+    int pid = 10030;
+    int uid = 20010030;
+    std::string bundleName = "com.ohos.reclaim_coalesce_test";
+    ReclaimPriorityManager::GetInstance().UpdateReclaimPriorityInner(
+        CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::CREATE_PROCESS));
+
+    std::vector<ReclaimPriorityManager::PendingUpdate> updates;
+    updates.push_back({CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::FOREGROUND), INVALID_TIME});
+    updates.push_back({CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::BACKGROUND), INVALID_TIME});
+    updates.push_back({CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::VISIBLE), INVALID_TIME});
+    // updates of a process not exist are dropped
+    updates.push_back({CreateUpdateRequest(pid + 1, uid, bundleName, AppStateUpdateReason::FOREGROUND),
+        INVALID_TIME});
+    uint64_t applyCount = ReclaimPriorityManager::GetInstance().coalescedApplyCount_;
+    ReclaimPriorityManager::GetInstance().ApplyCoalescedUpdates(updates);
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().coalescedApplyCount_ - applyCount, 1u);
+
+    int accountId = GetOsAccountIdByUid(uid);
+    std::shared_ptr<AccountBundleInfo> account = ReclaimPriorityManager::GetInstance().FindOsAccountById(accountId);
+    std::shared_ptr<BundlePriorityInfo> bundle = account->FindBundleById(uid);
+    ProcessPriorityInfo &proc = bundle->FindProcByPid(pid);
+    EXPECT_EQ(proc.isFreground, false);
+    EXPECT_EQ(proc.priority_, RECLAIM_PRIORITY_VISIBLE);
+    EXPECT_EQ(bundle->priority_, RECLAIM_PRIORITY_VISIBLE);
+
+    ReclaimPriorityManager::GetInstance().UpdateReclaimPriorityInner(
+        CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::PROCESS_TERMINATED));
+}
+
+HWTEST_F(ReclaimPriorityManagerTest, UpdateReclaimPriorityCoalescedTest, TestSize.Level1)
+{
+    int pid = 10031;
+    int uid = 20010031;
+    std::string bundleName = "com.ohos.reclaim_coalesce_test2";
+    ReclaimPriorityManager::GetInstance().UpdateReclaimPriorityInner(
+        CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::CREATE_PROCESS));
+    ReclaimPriorityManager::GetInstance().updateCoalesceWindowMs_ = 500; // 500: coalesce window of test
+    bool initialized = ReclaimPriorityManager::GetInstance().initialized_;
+    ReclaimPriorityManager::GetInstance().initialized_ = true;
+
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().UpdateReclaimPriority(
+        CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::FOREGROUND)), true);
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().UpdateReclaimPriority(
+        CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::BACKGROUND)), true);
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().pendingUpdates_.size(), 2u);
+    Sleep(1);
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().pendingUpdates_.size(), 0u);
+
+    int accountId = GetOsAccountIdByUid(uid);
+    std::shared_ptr<AccountBundleInfo> account = ReclaimPriorityManager::GetInstance().FindOsAccountById(accountId);
+    std::shared_ptr<BundlePriorityInfo> bundle = account->FindBundleById(uid);
+    EXPECT_EQ(bundle->FindProcByPid(pid).priority_, RECLAIM_PRIORITY_BACKGROUND);
+
+    // pending updates are applied before the termination, not after it
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().UpdateReclaimPriority(
+        CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::FOREGROUND)), true);
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().UpdateReclaimPriority(
+        CreateUpdateRequest(pid, uid, bundleName, AppStateUpdateReason::PROCESS_TERMINATED)), true);
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().pendingUpdates_.size(), 0u);
+    Sleep(1);
+    EXPECT_EQ(ReclaimPriorityManager::GetInstance().IsProcExist(pid, uid, accountId), false);
+
+    ReclaimPriorityManager::GetInstance().updateCoalesceWindowMs_ = 0;
+    ReclaimPriorityManager::GetInstance().initialized_ = initialized;
+}
+
+HWTEST_F(ReclaimPriorityManagerTest, ProcessPriorityInfoCompactTest, TestSize.Level1)
+{
+    ProcessPriorityInfo proc(1000, 20010000, RECLAIM_PRIORITY_BACKGROUND);
+    EXPECT_EQ(proc.GetPriorityByStatus(), RECLAIM_PRIORITY_UNKNOWN);
+    proc.hasUI_ = true;
+    EXPECT_EQ(proc.GetPriorityByStatus(), RECLAIM_PRIORITY_BACKGROUND);
+    proc.isDistDeviceConnected = true;
+    EXPECT_EQ(proc.GetPriorityByStatus(), RECLAIM_PRIORITY_BG_DIST_DEVICE);
+    proc.isEventStart = true;
+    EXPECT_EQ(proc.GetPriorityByStatus(), RECLAIM_PRIORITY_BG_PERCEIVED);
+    proc.isSuspendDelay = true;
+    EXPECT_EQ(proc.GetPriorityByStatus(), RECLAIM_PRIORITY_BG_SUSPEND_DELAY);
+    proc.isVisible_ = true;
+    EXPECT_EQ(proc.GetPriorityByStatus(), RECLAIM_PRIORITY_VISIBLE);
+    proc.isFreground = true;
+    EXPECT_EQ(proc.GetPriorityByStatus(), RECLAIM_PRIORITY_FOREGROUND);
+
+    // bindings are kept in order of pid, and copied deeply
+    EXPECT_EQ(proc.ExtensionConnectorsCount(), 0);
+    proc.ProcBindToMe(1003, 3);
+    proc.ProcBindToMe(1001, 1);
+    proc.ProcBindToMe(1002, 2);
+    proc.ProcBindToMe(1001, 4);
+    EXPECT_EQ(proc.ExtensionConnectorsCount(), 3);
+    EXPECT_EQ(proc.ProcsBindToMe(), "[(pid=1001, uid=4) (pid=1002, uid=2) (pid=1003, uid=3) ]");
+    ProcessPriorityInfo copy(proc);
+    proc.ProcUnBindToMe(1002);
+    proc.ProcUnBindToMe(1005);
+    EXPECT_EQ(proc.ExtensionConnectorsCount(), 2);
+    EXPECT_EQ(copy.ExtensionConnectorsCount(), 3);
+    EXPECT_TRUE(copy.isFreground);
+    proc.ProcUnBindToMe(1001);
+    proc.ProcUnBindToMe(1003);
+    EXPECT_TRUE(proc.procsBindToMe_.empty());
+    EXPECT_EQ(proc.ProcsBindToMe(), "[]");
+}
+
+HWTEST_F(ReclaimPriorityManagerTest, BundleNameTableTest, TestSize.Level1)
+{
+    BundleNameTable &table = BundleNameTable::GetInstance();
+    std::string name = "com.ohos.reclaim_test.name_table";
+    BundleNameTable::Id id = BundleNameTable::EMPTY_ID;
+    EXPECT_FALSE(table.Find(name, id));
+    size_t size = table.Size();
+
+    BundleName bundleName(name);
+    EXPECT_NE(bundleName.GetId(), BundleNameTable::EMPTY_ID);
+    EXPECT_EQ(table.Size(), size + 1);
+    EXPECT_TRUE(table.Find(name, id));
+    EXPECT_EQ(id, bundleName.GetId());
+    EXPECT_EQ(BundleName(name), bundleName);
+    EXPECT_EQ(table.Size(), size + 1);
+    EXPECT_EQ(bundleName, name);
+    EXPECT_STREQ(bundleName.c_str(), name.c_str());
+    EXPECT_TRUE(BundleName().empty());
+    EXPECT_EQ(BundleName().Str(), "");
+
+    // bundles share the interned name
+    BundlePriorityInfo bundle(name, 20010099, RECLAIM_PRIORITY_BACKGROUND);
+    BundlePriorityInfo copy(bundle.name_, bundle.uid_, bundle.priority_, bundle.accountId_, bundle.state_);
+    EXPECT_EQ(bundle.name_.GetId(), id);
+    EXPECT_EQ(copy.name_.GetId(), id);
+}
+
+HWTEST_F(ReclaimPriorityManagerTest, KeepAliveCacheTest, TestSize.Level1)
+{
+    ReclaimPriorityManager &manager = ReclaimPriorityManager::GetInstance();
+    int uid = 20010100;
+    auto bundle = std::make_shared<BundlePriorityInfo>("com.ohos.reclaim_test.keep_alive", uid,
+        RECLAIM_PRIORITY_BACKGROUND);
+    manager.keepAliveCache_[uid] = true;
+    manager.keepAliveCache_[uid + 1] = false;
+    EXPECT_TRUE(manager.IsKillableSystemApp(bundle));
+
+    // the answer is dropped once the package is changed
+    manager.NotifyPackageChanged(uid);
+    EXPECT_EQ(manager.keepAliveCache_.count(uid), 0u);
+    EXPECT_EQ(manager.keepAliveCache_.count(uid + 1), 1u);
+    manager.NotifyPackageChanged(-1);
+    EXPECT_TRUE(manager.keepAliveCache_.empty());
+}
+
+HWTEST_F(ReclaimPriorityManagerTest, ForegroundAppsTest, TestSize.Level1)
+{
+    ReclaimPriorityManager &manager = ReclaimPriorityManager::GetInstance();
+    int32_t uid = 20010101;
+    std::string name = "com.ohos.reclaim_test.foreground";
+    manager.foregroundAppsSynced_ = true;
+    manager.NotifyForegroundAppChanged(uid, name, true);
+    EXPECT_TRUE(manager.IsFrontApp(name, uid, 0));
+    EXPECT_FALSE(manager.IsFrontApp(name, uid + 1, 0));
+    EXPECT_FALSE(manager.IsFrontApp("com.ohos.reclaim_test.never_seen", uid, 0));
+
+    manager.NotifyForegroundAppChanged(uid, name, false);
+    EXPECT_FALSE(manager.IsFrontApp(name, uid, 0));
+
+    // callbacks during a sync are kept to be applied on top of the list fetched
+    uint64_t version = manager.foregroundAppsVersion_;
+    manager.foregroundAppsSyncing_ = 1;
+    manager.NotifyForegroundAppChanged(uid, name, true);
+    ASSERT_EQ(manager.foregroundAppChanges_.size(), 1u);
+    EXPECT_EQ(manager.foregroundAppChanges_[0].version, version + 1);
+    EXPECT_TRUE(manager.foregroundAppChanges_[0].isForeground);
+    manager.foregroundAppsSyncing_ = 0;
+    manager.foregroundAppChanges_.clear();
+    manager.NotifyForegroundAppChanged(uid, name, false);
+    EXPECT_TRUE(manager.foregroundAppChanges_.empty());
+
+    // the set is verified again after AppMgr reconnects
+    manager.Reset();
+    EXPECT_FALSE(manager.foregroundAppsSynced_);
+}
+
+HWTEST_F(ReclaimPriorityManagerTest, AbilityStartTimerFiredTest, TestSize.Level1)
+{
+    ReclaimPriorityManager &manager = ReclaimPriorityManager::GetInstance();
+    pid_t pid = 10060;
+    int32_t uid = 20010060;
+    manager.abilityStartTimers_.erase(pid);
+    manager.SetTimerForAbilityStartCompletedCheck(pid, uid, 0);
+    ASSERT_EQ(manager.abilityStartTimers_.count(pid), 1u);
+    TimerWheel::TimerId timerId = manager.abilityStartTimers_[pid];
+
+    // a timer replaced by a later one must not drop the entry of the later one
+    manager.CheckAbilityStartCompleted(pid, uid, 0, timerId + 1);
+    EXPECT_EQ(manager.abilityStartTimers_.count(pid), 1u);
+
+    // the entry is dropped once its timer fired
+    manager.CheckAbilityStartCompleted(pid, uid, 0, timerId);
+    EXPECT_EQ(manager.abilityStartTimers_.count(pid), 0u);
+    manager.timerWheel_.Cancel(timerId);
+}
 }
 }
\ No newline at end of file
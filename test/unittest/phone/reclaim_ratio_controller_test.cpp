@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "reclaim_ratio_controller.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+class ReclaimRatioControllerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void ReclaimRatioControllerTest::SetUpTestCase()
+{
+}
+
+void ReclaimRatioControllerTest::TearDownTestCase()
+{
+}
+
+void ReclaimRatioControllerTest::SetUp()
+{
+}
+
+void ReclaimRatioControllerTest::TearDown()
+{
+    ReclaimRatioController::GetInstance().states_.clear();
+    ReclaimRatioController::GetInstance().appStates_.clear();
+}
+
+static RatioControllerConfig MakeConfig()
+{
+    RatioControllerConfig config;
+    config.maxOffset = 10;
+    config.step = 5;
+    config.refaultHigh = 200;
+    config.refaultLow = 10;
+    return config;
+}
+
+HWTEST_F(ReclaimRatioControllerTest, NextOffsetTest, TestSize.Level1)
+{
+    RatioControllerConfig config = MakeConfig();
+    MemcgStat stat;
+    stat.anonKiB = 1024;
+    stat.zramKiB = 512;
+    stat.refaultsValid = true;
+
+    // thrashing memcg is backed off, but not beyond the bound
+    EXPECT_EQ(ReclaimRatioController::NextOffset(0, 500, stat, config), -5);
+    EXPECT_EQ(ReclaimRatioController::NextOffset(-10, 500, stat, config), -10);
+    // cold compressed pages push the memcg further
+    EXPECT_EQ(ReclaimRatioController::NextOffset(0, 0, stat, config), 5);
+    EXPECT_EQ(ReclaimRatioController::NextOffset(10, 0, stat, config), 10);
+    // refault rate between the thresholds keeps the offset
+    EXPECT_EQ(ReclaimRatioController::NextOffset(5, 100, stat, config), 5);
+    // nothing compressed yet, nothing tells the compressed pages are cold
+    stat.zramKiB = 0;
+    EXPECT_EQ(ReclaimRatioController::NextOffset(0, 0, stat, config), 0);
+    // refaults not counted, the offset goes back to 0
+    stat.zramKiB = 512;
+    stat.refaultsValid = false;
+    EXPECT_EQ(ReclaimRatioController::NextOffset(0, 0, stat, config), 0);
+    EXPECT_EQ(ReclaimRatioController::NextOffset(10, 0, stat, config), 0);
+
+    config.maxOffset = 0;
+    EXPECT_EQ(ReclaimRatioController::NextOffset(0, 500, stat, config), 0);
+}
+
+HWTEST_F(ReclaimRatioControllerTest, SetBaseRatiosTest, TestSize.Level1)
+{
+    ReclaimRatioController &controller = ReclaimRatioController::GetInstance();
+    controller.Init(MakeConfig());
+    unsigned int userId = 100;
+    ReclaimRatios ratios(60, 98, 50);
+    controller.SetBaseRatios(userId, ratios);
+    EXPECT_EQ(ratios.mem2zramRatio_, 60u);
+    EXPECT_EQ(controller.GetOffset(userId), 0);
+
+    // the offset is kept when priority of the user changes, ratios stay in [0, 100]
+    controller.states_[userId].offset = 5;
+    ReclaimRatios newRatios(30, 98, 50);
+    controller.SetBaseRatios(userId, newRatios);
+    EXPECT_EQ(newRatios.mem2zramRatio_, 35u);
+    EXPECT_EQ(newRatios.zram2ufsRatio_, 100u);
+    EXPECT_EQ(newRatios.refaultThreshold_, 50u);
+    EXPECT_EQ(controller.states_[userId].mem2zramRatio, 30u);
+
+    // users without memcg are forgotten
+    controller.Update({}, {});
+    EXPECT_EQ(controller.GetOffset(userId), 0);
+}
+
+HWTEST_F(ReclaimRatioControllerTest, SetAppBaseRatiosTest, TestSize.Level1)
+{
+    ReclaimRatioController &controller = ReclaimRatioController::GetInstance();
+    controller.Init(MakeConfig());
+    int appUid = 20010001;
+    ReclaimRatios ratios(60, 98, 50);
+    controller.SetAppBaseRatios(appUid, ratios);
+    EXPECT_EQ(ratios.mem2zramRatio_, 60u);
+    EXPECT_EQ(controller.GetAppOffset(appUid), 0);
+    EXPECT_EQ(controller.GetOffset(appUid), 0); // apps and users are apart
+
+    // ratios of config for a new priority of the app follow the offset of its memcg
+    controller.appStates_[appUid].offset = -10;
+    ReclaimRatios newRatios(30, 5, 50);
+    controller.SetAppBaseRatios(appUid, newRatios);
+    EXPECT_EQ(newRatios.mem2zramRatio_, 20u);
+    EXPECT_EQ(newRatios.zram2ufsRatio_, 0u);
+    EXPECT_EQ(controller.appStates_[appUid].mem2zramRatio, 30u);
+
+    // apps still having memcg are kept, others are forgotten
+    controller.Update({}, { appUid });
+    EXPECT_EQ(controller.GetAppOffset(appUid), -10);
+    controller.Update({}, {});
+    EXPECT_EQ(controller.GetAppOffset(appUid), 0);
+}
+}
+}
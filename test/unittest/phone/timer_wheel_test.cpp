@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "utils.h"
+
+#define private public
+#define protected public
+#include "timer_wheel.h"
+#undef private
+#undef protected
+
+namespace OHOS {
+namespace Memory {
+using namespace testing;
+using namespace testing::ext;
+
+class TimerWheelTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void TimerWheelTest::SetUpTestCase()
+{
+}
+
+void TimerWheelTest::TearDownTestCase()
+{
+}
+
+void TimerWheelTest::SetUp()
+{
+}
+
+void TimerWheelTest::TearDown()
+{
+}
+
+static size_t RunExpired(TimerWheel &wheel, int64_t nowMs)
+{
+    std::vector<TimerWheel::Callback> expired;
+    wheel.Advance(nowMs, expired);
+    for (auto &callback : expired) {
+        callback();
+    }
+    return expired.size();
+}
+
+HWTEST_F(TimerWheelTest, ScheduleAndExpireTest, TestSize.Level1)
+{
+    const int64_t tickMs = 10;
+    TimerWheel wheel(tickMs, 0);
+    EXPECT_EQ(wheel.NextWakeupMs(), -1);
+
+    std::vector<int> fired;
+    wheel.Schedule(0, 25, [&fired] { fired.push_back(1); });
+    wheel.Schedule(0, 10, [&fired] { fired.push_back(0); });
+    EXPECT_EQ(wheel.Size(), 2);
+    EXPECT_EQ(wheel.NextWakeupMs(), 10);
+
+    EXPECT_EQ(RunExpired(wheel, 9), 0);
+    EXPECT_EQ(RunExpired(wheel, 10), 1);
+    // rounded up to the tick, never expires early
+    EXPECT_EQ(wheel.NextWakeupMs(), 30);
+    EXPECT_EQ(RunExpired(wheel, 29), 0);
+    EXPECT_EQ(RunExpired(wheel, 30), 1);
+    EXPECT_EQ(fired, std::vector<int>({0, 1}));
+    EXPECT_EQ(wheel.Size(), 0);
+    EXPECT_EQ(wheel.NextWakeupMs(), -1);
+}
+
+HWTEST_F(TimerWheelTest, CancelTest, TestSize.Level1)
+{
+    TimerWheel wheel(10, 0);
+    int fired = 0;
+    TimerWheel::TimerId id = wheel.Schedule(0, 100, [&fired] { fired++; });
+    wheel.Schedule(0, 100, [&fired] { fired += 10; });
+    EXPECT_TRUE(wheel.Cancel(id));
+    EXPECT_FALSE(wheel.Cancel(id));
+    EXPECT_FALSE(wheel.Cancel(TimerWheel::INVALID_TIMER_ID));
+    EXPECT_EQ(RunExpired(wheel, 100), 1);
+    EXPECT_EQ(fired, 10);
+}
+
+HWTEST_F(TimerWheelTest, CascadeTest, TestSize.Level1)
+{
+    const int64_t tickMs = 1;
+    TimerWheel wheel(tickMs, 0);
+    // delays across levels and beyond the range of the wheel
+    std::vector<int64_t> delays = { 1, 63, 64, 65, 4095, 4096, 4097, 300000, 20000000 };
+    std::vector<int64_t> firedAt;
+    int64_t now = 0;
+    for (int64_t delay : delays) {
+        wheel.Schedule(0, delay, [&firedAt, &now] { firedAt.push_back(now); });
+    }
+    // jump from wakeup to wakeup as the owner does
+    while (wheel.Size() > 0) {
+        int64_t wakeup = wheel.NextWakeupMs();
+        ASSERT_GT(wakeup, now);
+        now = wakeup;
+        RunExpired(wheel, now);
+    }
+    EXPECT_EQ(firedAt, delays);
+}
+
+HWTEST_F(TimerWheelTest, ScheduleWhileAdvancedTest, TestSize.Level1)
+{
+    TimerWheel wheel(10, 1000);
+    int fired = 0;
+    EXPECT_EQ(RunExpired(wheel, 5000), 0);
+    wheel.Schedule(5000, 0, [&fired] { fired++; });
+    // a timer never expires at the tick processed already
+    EXPECT_EQ(wheel.NextWakeupMs(), 5010);
+    EXPECT_EQ(RunExpired(wheel, 6000), 1);
+    EXPECT_EQ(fired, 1);
+}
+} // namespace Memory
+} // namespace OHOS